@@ -0,0 +1,209 @@
+#include "ArrivalProfile.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+ArrivalProfile::ArrivalProfile(const std::vector<double>& pointTimes, const std::vector<double>& pointRates,
+  ProfileShape profileShape, double profilePeriod)
+  : times(pointTimes), rates(pointRates), shape(profileShape), period(profilePeriod), peakRate(0.0) {
+  if (times.empty() || times.size() != rates.size()) {
+    throw std::invalid_argument(" :          .");
+  }
+  if (times[0] != 0.0) {
+    throw std::invalid_argument(" :       0.");
+  }
+  for (size_t i = 0; i < times.size(); ++i) {
+    if (i > 0 && times[i] <= times[i - 1]) {
+      throw std::invalid_argument(" :    .");
+    }
+    if (rates[i] < 0.0 || !std::isfinite(rates[i])) {
+      throw std::invalid_argument(" :    .");
+    }
+  }
+  if (period < 0.0 || (period > 0.0 && period <= times.back())) {
+    throw std::invalid_argument(" :       .");
+  }
+
+  //  :         
+  maxRates.resize(times.size());
+  for (size_t i = 0; i < times.size(); ++i) {
+    maxRates[i] = (shape == ProfileShape::PIECEWISE_LINEAR) ? std::max(rates[i], endRate(i)) : rates[i];
+  }
+  peakRate = *std::max_element(maxRates.begin(), maxRates.end());
+}
+
+ArrivalProfile ArrivalProfile::loadFromFile(const std::string& path) {
+  std::ifstream in(path);
+  if (!in) {
+    throw std::runtime_error(" :     " + path);
+  }
+
+  std::vector<double> pointTimes;
+  std::vector<double> pointRates;
+  ProfileShape profileShape = ProfileShape::PIECEWISE_CONSTANT;
+  double profilePeriod = 0.0;
+
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(in, line)) {
+    ++lineNumber;
+    size_t comment = line.find('#');
+    if (comment != std::string::npos) {
+      line.erase(comment);
+    }
+    std::istringstream fields(line);
+    std::string first;
+    if (!(fields >> first)) {
+      continue; //  
+    }
+
+    bool ok = true;
+    if (first == "shape") {
+      std::string value;
+      ok = static_cast<bool>(fields >> value);
+      if (value == "constant") {
+        profileShape = ProfileShape::PIECEWISE_CONSTANT;
+      }
+      else if (value == "linear") {
+        profileShape = ProfileShape::PIECEWISE_LINEAR;
+      }
+      else {
+        ok = false;
+      }
+    }
+    else if (first == "period") {
+      ok = static_cast<bool>(fields >> profilePeriod);
+    }
+    else {
+      double t;
+      double rate;
+      std::istringstream timeField(first);
+      ok = (timeField >> t) && timeField.eof() && (fields >> rate);
+      if (ok) {
+        pointTimes.push_back(t);
+        pointRates.push_back(rate);
+      }
+    }
+
+    std::string rest;
+    if (!ok || (fields >> rest)) {
+      throw std::runtime_error("  " + path + ",  " + std::to_string(lineNumber) + ":  .");
+    }
+  }
+
+  return ArrivalProfile(pointTimes, pointRates, profileShape, profilePeriod);
+}
+
+size_t ArrivalProfile::segmentAt(double t) const {
+  auto it = std::upper_bound(times.begin(), times.end(), t);
+  return static_cast<size_t>(it - times.begin()) - 1;
+}
+
+double ArrivalProfile::segmentEnd(size_t segment) const {
+  if (segment + 1 < times.size()) {
+    return times[segment + 1];
+  }
+  return (period > 0.0) ? period : std::numeric_limits<double>::infinity();
+}
+
+double ArrivalProfile::endRate(size_t segment) const {
+  if (shape == ProfileShape::PIECEWISE_CONSTANT) {
+    return rates[segment];
+  }
+  if (segment + 1 < rates.size()) {
+    return rates[segment + 1];
+  }
+  //        
+  return (period > 0.0) ? rates[0] : rates[segment];
+}
+
+double ArrivalProfile::rateAt(double t) const {
+  double base = 0.0;
+  if (period > 0.0) {
+    base = std::floor(t / period) * period;
+  }
+  double local = std::max(0.0, t - base);
+  size_t segment = segmentAt(local);
+  if (shape == ProfileShape::PIECEWISE_CONSTANT) {
+    return rates[segment];
+  }
+  double end = segmentEnd(segment);
+  if (std::isinf(end)) {
+    return rates[segment];
+  }
+  double fraction = (local - times[segment]) / (end - times[segment]);
+  return rates[segment] + (endRate(segment) - rates[segment]) * fraction;
+}
+
+double ArrivalProfile::majorantAt(double t) const {
+  double base = 0.0;
+  if (period > 0.0) {
+    base = std::floor(t / period) * period;
+  }
+  return maxRates[segmentAt(std::max(0.0, t - base))];
+}
+
+double ArrivalProfile::nextArrival(double currentTime, std::default_random_engine& generator) const {
+  if (peakRate <= 0.0) {
+    return std::numeric_limits<double>::infinity(); //  
+  }
+  std::exponential_distribution<double> unitExp(1.0);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+  //          
+  double base = 0.0;
+  if (period > 0.0) {
+    base = std::floor(currentTime / period) * period;
+  }
+  double local = std::max(0.0, currentTime - base);
+  size_t segment = segmentAt(local);
+
+  while (true) {
+    double end = segmentEnd(segment);
+    double bound = maxRates[segment];
+
+    if (bound > 0.0) {
+      //       
+      double candidate = local + unitExp(generator) / bound;
+      if (candidate < end) {
+        local = candidate;
+        if (shape == ProfileShape::PIECEWISE_CONSTANT || unit(generator) * bound <= rateAt(base + local)) {
+          return base + local;
+        }
+        continue; //  ,    
+      }
+    }
+    else if (std::isinf(end)) {
+      return std::numeric_limits<double>::infinity(); //    
+    }
+
+    //   :       
+    local = end;
+    ++segment;
+    if (segment == times.size()) {
+      //   (        )
+      base += period;
+      local = 0.0;
+      segment = 0;
+    }
+  }
+}
+
+double ArrivalProfile::getMeanRate() const {
+  double horizon = (period > 0.0) ? period : times.back();
+  if (horizon <= 0.0) {
+    return rates[0];
+  }
+  double integral = 0.0;
+  for (size_t i = 0; i < times.size(); ++i) {
+    double end = std::min(segmentEnd(i), horizon);
+    if (end <= times[i]) {
+      continue;
+    }
+    integral += (rates[i] + endRate(i)) / 2.0 * (end - times[i]);
+  }
+  return integral / horizon;
+}
@@ -0,0 +1,65 @@
+#ifndef ARRIVALPROFILE_H
+#define ARRIVALPROFILE_H
+
+#include <random>
+#include <vector>
+#include <string>
+
+//       
+enum class ProfileShape {
+  PIECEWISE_CONSTANT, //     
+  PIECEWISE_LINEAR    //        
+};
+
+//     lambda(t) (    ).
+//     (, ),   -   0.
+//  period > 0      (, ),  
+//     .
+//
+//     (Lewis-Shedler)  -
+// :          
+//        lambda(t) / .  -
+//     ,      .
+//     ,      
+class ArrivalProfile {
+private:
+  std::vector<double> times;    //   (times[0] == 0)
+  std::vector<double> rates;    //    
+  std::vector<double> maxRates; //   
+  ProfileShape shape;
+  double period;                // 0 -   
+  double peakRate;              //  
+
+  //  ,   t  
+  size_t segmentAt(double t) const;
+  //      (     )
+  double segmentEnd(size_t segment) const;
+  //    
+  double endRate(size_t segment) const;
+
+public:
+  ArrivalProfile(const std::vector<double>& pointTimes, const std::vector<double>& pointRates,
+    ProfileShape profileShape, double profilePeriod = 0.0);
+
+  //     . :  " ",
+  //   "shape constant|linear"  "period P",   '#'
+  static ArrivalProfile loadFromFile(const std::string& path);
+
+  //    t
+  double rateAt(double t) const;
+
+  //     t,   rateAt(t)
+  double majorantAt(double t) const;
+
+  //     currentTime.  ,
+  //      
+  double nextArrival(double currentTime, std::default_random_engine& generator) const;
+
+  //     (    -     )
+  double getMeanRate() const;
+
+  double getPeriod() const { return period; }
+  ProfileShape getShape() const { return shape; }
+};
+
+#endif
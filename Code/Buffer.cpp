@@ -1,9 +1,47 @@
 #include "Buffer.h"
 #include <stdexcept>
 
-Buffer::Buffer(int cap) : capacity(cap), ringPointer(0) {
+Buffer::Buffer(int cap) : capacity(cap), ringPointer(0), occupiedCount(0) {
   slots.resize(capacity);
   occupied.resize(capacity, false);
+  slotKeys.resize(capacity);
+}
+
+Buffer::SlotKey Buffer::makeKey(const Request& req, int slot) const {
+  double priority = static_cast<double>(req.getPriority());
+  switch (selection.discipline) {
+  case SelectionDiscipline::EDF:
+    return SlotKey{ fromSimTime(req.getCreationTime()) + selection.deadlineFor(req.getPriority()), -priority, slot };
+  case SelectionDiscipline::AGING:
+    return SlotKey{ selection.agingRate * fromSimTime(req.getTimeEnteredBuffer()) - priority, -priority, slot };
+  default:
+    // D24:       -   
+    return SlotKey{ -priority, -fromSimTime(req.getTimeEnteredBuffer()), slot };
+  }
+}
+
+void Buffer::placeRequest(int index, const Request& req) {
+  if (occupied[index]) {
+    selectionIndex.erase(slotKeys[index]);
+  }
+  else {
+    occupied[index] = true;
+    occupiedCount++;
+  }
+  slots[index] = req;
+  slotKeys[index] = makeKey(req, index);
+  selectionIndex.insert(slotKeys[index]);
+}
+
+void Buffer::setSelectionPolicy(const SelectionPolicy& policy) {
+  selection = policy;
+  selectionIndex.clear();
+  for (int i = 0; i < capacity; ++i) {
+    if (occupied[i]) {
+      slotKeys[i] = makeKey(slots[i], i);
+      selectionIndex.insert(slotKeys[i]);
+    }
+  }
 }
 
 bool Buffer::addRequest(const Request& req, Request& replacedReq) {
@@ -19,8 +57,7 @@ bool Buffer::addRequest(const Request& req, Request& replacedReq) {
       wasReplaced = true; // ,   
       replacedReq.updateStatus(RequestStatus::REJECTED); //    REJECTED
       //     
-      slots[replaceIndex] = req;
-      occupied[replaceIndex] = true; // ,     
+      placeRequest(replaceIndex, req);
     }
     else {
       return false;
@@ -38,8 +75,7 @@ bool Buffer::addRequest(const Request& req, Request& replacedReq) {
       }
     }
     if (insertIndex != -1) {
-      slots[insertIndex] = req; //  req   timeEnteredBuffer
-      occupied[insertIndex] = true;
+      placeRequest(insertIndex, req); //  req   timeEnteredBuffer
       //        
       ringPointer = (insertIndex + 1) % capacity;
     }
@@ -50,9 +86,72 @@ bool Buffer::addRequest(const Request& req, Request& replacedReq) {
   return true;
 }
 
+void Buffer::swapSlots(int a, int b) {
+  Request moved = slots[a];
+  placeRequest(a, slots[b]);
+  placeRequest(b, moved);
+}
+
+bool Buffer::reinsert(const Request& req, Request& replacedReq) {
+  int index = -1;
+  if (isFull()) {
+    index = findRequestForReplacement();
+    if (index == -1) {
+      return false;
+    }
+    if (slots[index].getTimeEnteredBuffer() <= req.getTimeEnteredBuffer()) {
+      //     -   
+      replacedReq = req;
+      replacedReq.updateStatus(RequestStatus::REJECTED);
+      return true;
+    }
+    replacedReq = slots[index];
+    replacedReq.updateStatus(RequestStatus::REJECTED);
+  }
+  else {
+    index = findNextFreeSlot();
+  }
+  placeRequest(index, req);
+
+  //    ,         
+  SimTime entered = req.getTimeEnteredBuffer();
+  bool moved = true;
+  while (moved) {
+    moved = false;
+    for (int i = ringOffset(index) - 1; i >= 0; --i) {
+      int prev = (ringPointer + i) % capacity;
+      if (occupied[prev]) {
+        if (slots[prev].getTimeEnteredBuffer() > entered) {
+          swapSlots(prev, index);
+          index = prev;
+          moved = true;
+        }
+        break;
+      }
+    }
+    if (moved) {
+      continue;
+    }
+    for (int i = ringOffset(index) + 1; i < capacity; ++i) {
+      int next = (ringPointer + i) % capacity;
+      if (occupied[next]) {
+        if (slots[next].getTimeEnteredBuffer() < entered) {
+          swapSlots(next, index);
+          index = next;
+          moved = true;
+        }
+        break;
+      }
+    }
+  }
+  return true;
+}
+
 void Buffer::markSlotFree(int index) {
-  if (index >= 0 && index < capacity) {
+  if (index >= 0 && index < capacity && occupied[index]) {
+    selectionIndex.erase(slotKeys[index]);
     occupied[index] = false;
+    occupiedCount--;
   }
 }
 
@@ -87,23 +186,13 @@ int Buffer::findRequestForReplacement() {
 }
 
 bool Buffer::isFull() const {
-  for (bool occ : occupied) {
-    if (!occ) return false;
-  }
-  return true;
+  return occupiedCount >= capacity;
 }
 
 bool Buffer::isEmpty() const {
-  for (bool occ : occupied) {
-    if (occ) return false;
-  }
-  return true;
+  return occupiedCount == 0;
 }
 
 int Buffer::getCurrentSize() const {
-  int count = 0;
-  for (bool occ : occupied) {
-    if (occ) count++;
-  }
-  return count;
+  return occupiedCount;
 }
\ No newline at end of file
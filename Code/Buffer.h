@@ -2,15 +2,61 @@
 #define BUFFER_H
 
 #include <vector>
+#include <set>
 #include "Request.h"
 #include <optional>
 
+//       
+enum class SelectionDiscipline {
+  LIFO_PRIORITY, // D24:  ,   -  
+  EDF,           //   (  +   ),   -  
+  AGING          //     : priority + agingRate * ,  
+};
+
+//   
+struct SelectionPolicy {
+  SelectionDiscipline discipline;
+  double deadlines[3]; //        ( -  Priority)
+  double agingRate;    //       (AGING)
+
+  SelectionPolicy() : discipline(SelectionDiscipline::LIFO_PRIORITY), deadlines{ 80.0, 40.0, 10.0 }, agingRate(0.01) {}
+
+  double deadlineFor(Priority p) const { return deadlines[static_cast<int>(p)]; }
+};
+
 class Buffer {
 private:
+  //   :      
+  struct SlotKey {
+    double primary;
+    double secondary;
+    int slot;
+
+    bool operator<(const SlotKey& other) const {
+      if (primary != other.primary) return primary < other.primary;
+      if (secondary != other.secondary) return secondary < other.secondary;
+      return slot < other.slot;
+    }
+  };
+
   int capacity;                       //  
   std::vector<Request> slots;         //     
   std::vector<bool> occupied;         //     
   int ringPointer;                    //    
+  int occupiedCount;                  //   
+
+  //    :   O(1),     O(log n).
+  //      ,          
+  // :   priority + rate * (now - t)   ,  priority - rate * t
+  SelectionPolicy selection;
+  std::set<SlotKey> selectionIndex;
+  std::vector<SlotKey> slotKeys;      //     (   )
+
+  SlotKey makeKey(const Request& req, int slot) const;
+  void placeRequest(int index, const Request& req);
+  void swapSlots(int a, int b);
+  //     :   ,    
+  int ringOffset(int index) const { return (index - ringPointer + capacity) % capacity; }
 
 public:
   Buffer(int cap);
@@ -18,6 +64,12 @@ public:
   //          D1031
   bool addRequest(const Request& req, Request& replacedReq);
 
+  //      ,     ( ).
+  //    ,         ,
+  //  D1004 -    .   ,
+  //         (     replacedReq)
+  bool reinsert(const Request& req, Request& replacedReq);
+
   //        D24
   void markSlotFree(int index);
 
@@ -27,6 +79,13 @@ public:
   //     ,    D1004
   int findRequestForReplacement();
 
+  //      ,   , -1 -  
+  int selectSlot() const { return selectionIndex.empty() ? -1 : selectionIndex.begin()->slot; }
+
+  //      ( )
+  void setSelectionPolicy(const SelectionPolicy& policy);
+  const SelectionPolicy& getSelectionPolicy() const { return selection; }
+
   bool isFull() const;
   bool isEmpty() const;
 
@@ -0,0 +1,79 @@
+#include "BufferBenchmark.h"
+#include "Buffer.h"
+#include "Dispatcher.h"
+#include "ConcurrentBuffer.h"
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+
+namespace {
+
+//  threadCount ,    add/take,     
+template <typename AddFn, typename TakeFn>
+double measure(int threadCount, double seconds, AddFn addFn, TakeFn takeFn) {
+  std::atomic<bool> running(true);
+  std::vector<long long> ops(threadCount, 0);
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < threadCount; ++t) {
+    threads.emplace_back([&, t]() {
+      int requestId = t + 1;
+      long long count = 0;
+      Request replacedReq;
+      Request takenReq;
+      while (running.load(std::memory_order_relaxed)) {
+        Request req(requestId, requestId % 3 + 1, 0.0, static_cast<Priority>(requestId % 3));
+        requestId += threadCount;
+        addFn(req, replacedReq);
+        takeFn(takenReq);
+        count += 2;
+      }
+      ops[t] = count;
+    });
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+  running = false;
+  for (auto& t : threads) {
+    t.join();
+  }
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  long long total = 0;
+  for (long long n : ops) {
+    total += n;
+  }
+  return total / elapsed;
+}
+
+}
+
+void runBufferBenchmark(int threadCount, int bufferSize, double seconds) {
+  Buffer buffer(bufferSize);
+  Dispatcher dispatcher(&buffer, {});
+  std::mutex bufferMutex;
+
+  double lockedOps = measure(threadCount, seconds,
+    [&](const Request& req, Request& replacedReq) {
+      std::lock_guard<std::mutex> lock(bufferMutex);
+      buffer.addRequest(req, replacedReq);
+    },
+    [&](Request& out) {
+      std::lock_guard<std::mutex> lock(bufferMutex);
+      dispatcher.takeRequest(out);
+    });
+
+  ConcurrentBuffer concurrentBuffer(bufferSize);
+  double concurrentOps = measure(threadCount, seconds,
+    [&](const Request& req, Request& replacedReq) { concurrentBuffer.addRequest(req, replacedReq); },
+    [&](Request& out) { concurrentBuffer.takeRequest(out); });
+
+  std::cout << "\n---   (: " << threadCount << ", : " << bufferSize << ") ---" << std::endl;
+  std::cout << std::setw(30) << "Buffer + std::mutex: " << std::fixed << std::setprecision(0) << lockedOps << " ./" << std::endl;
+  std::cout << std::setw(30) << "ConcurrentBuffer: " << concurrentOps << " ./" << std::endl;
+}
@@ -0,0 +1,8 @@
+#ifndef BUFFERBENCHMARK_H
+#define BUFFERBENCHMARK_H
+
+//    ConcurrentBuffer  Buffer   .
+//          
+void runBufferBenchmark(int threadCount, int bufferSize, double seconds);
+
+#endif
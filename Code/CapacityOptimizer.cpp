@@ -0,0 +1,237 @@
+#include "CapacityOptimizer.h"
+#include "Statistics.h"
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+namespace {
+
+const char* statusToString(CandidateStatus status) {
+  switch (status) {
+  case CandidateStatus::ACTIVE: return " ";
+  case CandidateStatus::FEASIBLE: return "";
+  case CandidateStatus::INFEASIBLE: return "";
+  case CandidateStatus::DOMINATED: return "";
+  default: return "?";
+  }
+}
+
+}
+
+SlaTargets::SlaTargets() : maxP99Waiting(60.0) {
+  maxRejectionProbability[static_cast<int>(Priority::PRIVATE)] = 0.4;
+  maxRejectionProbability[static_cast<int>(Priority::CORPORATE)] = 0.2;
+  maxRejectionProbability[static_cast<int>(Priority::WARRANTY)] = 0.05;
+}
+
+OptimizerSettings::OptimizerSettings()
+  : minDevices(1), maxDevices(8), minBufferSize(1), maxBufferSize(10),
+  initialReplications(3), replicationsPerRound(3), maxReplications(30), baseSeed(12345), errorRate(0.05) {
+  threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+CapacityCandidate::CapacityCandidate(int devices, int bufSize)
+  : deviceCount(devices), bufferSize(bufSize), status(CandidateStatus::ACTIVE), decidedByLimit(false) {}
+
+CapacityOptimizer::CapacityOptimizer(const SimulationConfig& base, const SlaTargets& sla, const OptimizerSettings& optimizerSettings)
+  : baseConfig(base), targets(sla), settings(optimizerSettings), comparisonAlpha(optimizerSettings.errorRate) {
+  for (int d = settings.minDevices; d <= settings.maxDevices; ++d) {
+    for (int b = settings.minBufferSize; b <= settings.maxBufferSize; ++b) {
+      candidates.emplace_back(d, b);
+    }
+  }
+}
+
+bool CapacityOptimizer::isSmaller(const CapacityCandidate& a, const CapacityCandidate& b) {
+  if (a.deviceCount != b.deviceCount) {
+    return a.deviceCount < b.deviceCount;
+  }
+  return a.bufferSize < b.bufferSize;
+}
+
+void CapacityOptimizer::runReplications(const std::vector<int>& candidateIndices, int targetReplications) {
+  //  -   (,  )
+  struct Task {
+    int candidate;
+    int replication;
+    SimulationResults results;
+  };
+  std::vector<Task> tasks;
+  for (int index : candidateIndices) {
+    for (int r = candidates[index].getReplications(); r < targetReplications; ++r) {
+      tasks.push_back(Task{ index, r, SimulationResults() });
+    }
+  }
+
+  std::atomic<size_t> nextTask(0);
+  auto worker = [&]() {
+    size_t t;
+    while ((t = nextTask.fetch_add(1)) < tasks.size()) {
+      Task& task = tasks[t];
+      SimulationConfig config = baseConfig;
+      config.deviceCount = candidates[task.candidate].deviceCount;
+      config.bufferSize = candidates[task.candidate].bufferSize;
+      //   :         
+      config.seed = settings.baseSeed + 7919u * static_cast<unsigned>(task.replication + 1);
+      SimulationController controller(config);
+      controller.runToCompletion();
+      task.results = controller.getResults();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  int threadCount = std::min<int>(settings.threadCount, static_cast<int>(tasks.size()));
+  for (int i = 0; i < threadCount; ++i) {
+    threads.emplace_back(worker);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  //         
+  for (const Task& task : tasks) {
+    CapacityCandidate& c = candidates[task.candidate];
+    for (int p = 0; p < 3; ++p) {
+      c.rejection[p].push_back(task.results.rejectionProbability(static_cast<Priority>(p)));
+    }
+    c.p99Waiting.push_back(task.results.p99Waiting);
+  }
+}
+
+void CapacityOptimizer::classify(CapacityCandidate& candidate) {
+  if (candidate.getReplications() < 2) {
+    return;
+  }
+
+  bool allBelow = true;
+  auto check = [&](const std::vector<double>& values, double target) {
+    double m = sampleMean(values);
+    double h = confidenceHalfWidth(values, comparisonAlpha);
+    if (m - h > target) {
+      candidate.status = CandidateStatus::INFEASIBLE;
+    }
+    if (m + h > target) {
+      allBelow = false;
+    }
+  };
+
+  for (int p = 0; p < 3; ++p) {
+    check(candidate.rejection[p], targets.maxRejectionProbability[p]);
+  }
+  check(candidate.p99Waiting, targets.maxP99Waiting);
+
+  if (candidate.status == CandidateStatus::ACTIVE && allBelow) {
+    candidate.status = CandidateStatus::FEASIBLE;
+  }
+}
+
+void CapacityOptimizer::eliminate() {
+  for (const CapacityCandidate& decided : candidates) {
+    for (CapacityCandidate& other : candidates) {
+      if (decided.status == CandidateStatus::FEASIBLE &&
+        (other.status == CandidateStatus::ACTIVE || other.status == CandidateStatus::FEASIBLE) &&
+        isSmaller(decided, other)) {
+        //      
+        other.status = CandidateStatus::DOMINATED;
+      }
+      else if (decided.status == CandidateStatus::INFEASIBLE && other.status == CandidateStatus::ACTIVE &&
+        other.bufferSize == decided.bufferSize && other.deviceCount < decided.deviceCount) {
+        //           ,  
+        other.status = CandidateStatus::INFEASIBLE;
+      }
+    }
+  }
+}
+
+int CapacityOptimizer::optimize() {
+  //            .
+  //       ,      
+  int perRound = std::max(1, settings.replicationsPerRound);
+  int rounds = 1 + std::max(0, settings.maxReplications - settings.initialReplications + perRound - 1) / perRound;
+  int comparisons = static_cast<int>(candidates.size()) * 4 * rounds;
+  comparisonAlpha = settings.errorRate / std::max(1, comparisons);
+
+  int replications = settings.initialReplications;
+  while (true) {
+    std::vector<int> active;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      if (candidates[i].status == CandidateStatus::ACTIVE) {
+        active.push_back(static_cast<int>(i));
+      }
+    }
+    if (active.empty()) {
+      break;
+    }
+
+    runReplications(active, replications);
+    for (int index : active) {
+      classify(candidates[index]);
+    }
+    eliminate();
+
+    if (replications >= settings.maxReplications) {
+      //    -     
+      for (CapacityCandidate& c : candidates) {
+        if (c.status != CandidateStatus::ACTIVE) {
+          continue;
+        }
+        bool meetsTargets = sampleMean(c.p99Waiting) <= targets.maxP99Waiting;
+        for (int p = 0; p < 3; ++p) {
+          meetsTargets = meetsTargets && sampleMean(c.rejection[p]) <= targets.maxRejectionProbability[p];
+        }
+        c.status = meetsTargets ? CandidateStatus::FEASIBLE : CandidateStatus::INFEASIBLE;
+        c.decidedByLimit = true;
+      }
+      eliminate();
+      break;
+    }
+    replications = std::min(replications + settings.replicationsPerRound, settings.maxReplications);
+  }
+
+  int best = -1;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    if (candidates[i].status == CandidateStatus::FEASIBLE && (best < 0 || isSmaller(candidates[i], candidates[best]))) {
+      best = static_cast<int>(i);
+    }
+  }
+  return best;
+}
+
+void CapacityOptimizer::printReport(int bestIndex) const {
+  std::cout << "\n---------------    SLA ---------------\n" << std::endl;
+  std::cout << ": P  (//) <= " << std::fixed << std::setprecision(3)
+    << targets.maxRejectionProbability[static_cast<int>(Priority::WARRANTY)] << "/"
+    << targets.maxRejectionProbability[static_cast<int>(Priority::CORPORATE)] << "/"
+    << targets.maxRejectionProbability[static_cast<int>(Priority::PRIVATE)]
+    << ", p99 T <= " << targets.maxP99Waiting << std::endl;
+  std::cout << "     <= " << settings.errorRate
+    << " (   " << std::scientific << std::setprecision(2) << comparisonAlpha << std::fixed << ")" << std::endl << std::endl;
+
+  std::cout << std::setw(8) << "" << std::setw(8) << "" << std::setw(10) << "" << std::setw(14) << ""
+    << std::setw(10) << "P " << std::setw(10) << "P " << std::setw(10) << "P " << std::setw(12) << "p99 T" << std::endl;
+
+  int totalReplications = 0;
+  for (const CapacityCandidate& c : candidates) {
+    totalReplications += c.getReplications();
+    std::cout << std::setw(8) << c.deviceCount << std::setw(8) << c.bufferSize << std::setw(10) << c.getReplications()
+      << std::setw(14) << statusToString(c.status) << (c.decidedByLimit ? "*" : " ")
+      << std::setw(9) << std::setprecision(4) << sampleMean(c.rejection[static_cast<int>(Priority::WARRANTY)])
+      << std::setw(10) << sampleMean(c.rejection[static_cast<int>(Priority::CORPORATE)])
+      << std::setw(10) << sampleMean(c.rejection[static_cast<int>(Priority::PRIVATE)])
+      << std::setw(12) << std::setprecision(2) << sampleMean(c.p99Waiting) << std::endl;
+  }
+
+  std::cout << "\n* -     " << settings.maxReplications << " " << std::endl;
+  std::cout << " : " << totalReplications << "  " << candidates.size() * settings.maxReplications
+    << "   " << std::endl;
+  if (bestIndex >= 0) {
+    std::cout << "  :  " << candidates[bestIndex].deviceCount
+      << ",   " << candidates[bestIndex].bufferSize << std::endl;
+  }
+  else {
+    std::cout << "       SLA." << std::endl;
+  }
+}
@@ -0,0 +1,89 @@
+#ifndef CAPACITYOPTIMIZER_H
+#define CAPACITYOPTIMIZER_H
+
+#include "SimulationController.h"
+#include <vector>
+
+//   (SLA)
+struct SlaTargets {
+  double maxRejectionProbability[3]; //  P    ( -  Priority)
+  double maxP99Waiting;              //  99-  T 
+
+  SlaTargets();
+};
+
+//  
+struct OptimizerSettings {
+  int minDevices;
+  int maxDevices;
+  int minBufferSize;
+  int maxBufferSize;
+  int initialReplications;   //      
+  int replicationsPerRound;  // ,     
+  int maxReplications;       //    
+  int threadCount;           //   
+  unsigned baseSeed;         //  r         
+  double errorRate;          //          
+
+  OptimizerSettings();
+};
+
+enum class CandidateStatus {
+  ACTIVE,       //    
+  FEASIBLE,     // SLA     
+  INFEASIBLE,   // SLA     
+  DOMINATED     // :     
+};
+
+struct CapacityCandidate {
+  int deviceCount;
+  int bufferSize;
+  CandidateStatus status;
+  bool decidedByLimit;   //        
+  //   : P     99-  T 
+  std::vector<double> rejection[3];
+  std::vector<double> p99Waiting;
+
+  CapacityCandidate(int devices, int bufSize);
+  int getReplications() const { return static_cast<int>(p99Waiting.size()); }
+};
+
+//    (   ,    ),
+//  SLA.    ;   
+//         ,
+//     .     
+//     ( x  x ),     
+//       errorRate
+class CapacityOptimizer {
+private:
+  SimulationConfig baseConfig;
+  SlaTargets targets;
+  OptimizerSettings settings;
+  std::vector<CapacityCandidate> candidates;
+  double comparisonAlpha; //       
+
+  //       
+  void runReplications(const std::vector<int>& candidateIndices, int targetReplications);
+
+  //     
+  void classify(CapacityCandidate& candidate);
+
+  //      
+  void eliminate();
+
+  // true,   a  b ( ,  )
+  static bool isSmaller(const CapacityCandidate& a, const CapacityCandidate& b);
+
+public:
+  CapacityOptimizer(const SimulationConfig& base, const SlaTargets& sla, const OptimizerSettings& optimizerSettings);
+
+  //    .      -1
+  int optimize();
+
+  const std::vector<CapacityCandidate>& getCandidates() const { return candidates; }
+
+  //     
+  void printReport(int bestIndex) const;
+};
+
+#endif
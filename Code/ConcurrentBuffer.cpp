@@ -0,0 +1,108 @@
+#include "ConcurrentBuffer.h"
+#include <thread>
+#include <functional>
+
+ConcurrentBuffer::ConcurrentBuffer(int cap, int shardsPerPri)
+  : capacity(cap), shardsPerPriority(shardsPerPri > 0 ? shardsPerPri : 1), size(0), nextSeq(1) {
+  shards.reset(new Shard[PRIORITY_COUNT * shardsPerPriority]);
+  for (int i = 0; i < PRIORITY_COUNT * shardsPerPriority; ++i) {
+    shards[i].stack.reserve(capacity);
+  }
+}
+
+ConcurrentBuffer::Shard* ConcurrentBuffer::findMostRecent(int first, int last, unsigned long long& seq) {
+  Shard* best = nullptr;
+  seq = 0;
+  for (int i = first; i < last; ++i) {
+    unsigned long long top = shards[i].topSeq.load(std::memory_order_acquire);
+    if (top > seq) {
+      seq = top;
+      best = &shards[i];
+    }
+  }
+  return best;
+}
+
+void ConcurrentBuffer::push(Shard& shard, const Request& req) {
+  unsigned long long seq = nextSeq.fetch_add(1, std::memory_order_relaxed);
+  std::lock_guard<std::mutex> guard(shard.lock);
+  shard.stack.push_back(Entry{ req, seq });
+  //     ,   ,     -   
+  for (size_t i = shard.stack.size() - 1; i > 0 && shard.stack[i - 1].seq > shard.stack[i].seq; --i) {
+    std::swap(shard.stack[i - 1], shard.stack[i]);
+  }
+  shard.topSeq.store(shard.stack.back().seq, std::memory_order_release);
+}
+
+bool ConcurrentBuffer::popIfTop(Shard& shard, unsigned long long expectedSeq, Request& out) {
+  std::lock_guard<std::mutex> guard(shard.lock);
+  if (shard.stack.empty() || shard.stack.back().seq != expectedSeq) {
+    return false;
+  }
+  out = shard.stack.back().request;
+  shard.stack.pop_back();
+  shard.topSeq.store(shard.stack.empty() ? 0 : shard.stack.back().seq, std::memory_order_release);
+  return true;
+}
+
+bool ConcurrentBuffer::addRequest(const Request& req, Request& replacedReq) {
+  //    ,        .
+  //  ,      [0, shardsPerPriority)
+  static thread_local size_t threadHash = std::hash<std::thread::id>()(std::this_thread::get_id()) >> 4;
+  Shard& target = shardFor(req.getPriority(), threadHash % static_cast<size_t>(shardsPerPriority));
+
+  int spins = 0;
+  while (true) {
+    //    -   (D1031)
+    int current = size.load(std::memory_order_relaxed);
+    while (current < capacity) {
+      if (size.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel)) {
+        push(target, req);
+        return true;
+      }
+    }
+
+    //   -     (D1004).
+    //      ,    
+    unsigned long long seq;
+    Shard* victim = findMostRecent(0, PRIORITY_COUNT * shardsPerPriority, seq);
+    if (!victim) {
+      //  ,     ,    .
+      //      -      
+      if (++spins >= 64) {
+        std::this_thread::yield();
+        spins = 0;
+      }
+      continue;
+    }
+    if (popIfTop(*victim, seq, replacedReq)) {
+      replacedReq.updateStatus(RequestStatus::REJECTED);
+      push(target, req);
+      return true;
+    }
+  }
+}
+
+bool ConcurrentBuffer::takeRequest(Request& out) {
+  while (size.load(std::memory_order_acquire) > 0) {
+    bool sawCandidate = false;
+    // D24:     ,   -   
+    for (int p = PRIORITY_COUNT - 1; p >= 0; --p) {
+      unsigned long long seq;
+      Shard* shard = findMostRecent(p * shardsPerPriority, (p + 1) * shardsPerPriority, seq);
+      if (!shard) {
+        continue;
+      }
+      sawCandidate = true;
+      if (popIfTop(*shard, seq, out)) {
+        size.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+      }
+      break; //   -   
+    }
+    if (!sawCandidate) {
+      return false; //  ,     
+    }
+  }
+  return false;
+}
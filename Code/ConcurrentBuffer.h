@@ -0,0 +1,71 @@
+#ifndef CONCURRENTBUFFER_H
+#define CONCURRENTBUFFER_H
+
+#include "Request.h"
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <memory>
+
+//      Buffer:
+//  - addRequest:   ,       (D1004)
+//  - takeRequest:     ,   -   (D24)
+//       Buffer.   
+//      :   ,   
+// ,  addRequest   ,      , 
+//  . " "  ,  
+//  ,         
+//
+//   .     (    ),
+//   -    .     ,
+//         ,
+//           .
+class ConcurrentBuffer {
+private:
+  struct Entry {
+    Request request;
+    unsigned long long seq; //   
+  };
+
+  //    -,      
+  struct alignas(64) Shard {
+    std::mutex lock;
+    std::vector<Entry> stack;                   // LIFO:  -   
+    std::atomic<unsigned long long> topSeq;     //    , 0 -  
+
+    Shard() : topSeq(0) {}
+  };
+
+  static const int PRIORITY_COUNT = 3;
+
+  int capacity;                                //  
+  int shardsPerPriority;                       //     
+  std::unique_ptr<Shard[]> shards;             // [ * shardsPerPriority + ]
+  alignas(64) std::atomic<int> size;           //   (  )
+  alignas(64) std::atomic<unsigned long long> nextSeq;
+
+  Shard& shardFor(Priority p, size_t index) { return shards[static_cast<size_t>(p) * shardsPerPriority + index]; }
+
+  //       [first, last), nullptr -  
+  Shard* findMostRecent(int first, int last, unsigned long long& seq);
+
+  void push(Shard& shard, const Request& req);
+  bool popIfTop(Shard& shard, unsigned long long expectedSeq, Request& out);
+
+public:
+  ConcurrentBuffer(int cap, int shardsPerPri = 4);
+
+  //     (Buffer::addRequest  ,  ):
+  //   replacedReq      REJECTED
+  bool addRequest(const Request& req, Request& replacedReq);
+
+  //       (D24).  false,   
+  bool takeRequest(Request& out);
+
+  int getCapacity() const { return capacity; }
+  int getCurrentSize() const { return size.load(std::memory_order_relaxed); }
+  bool isEmpty() const { return getCurrentSize() == 0; }
+  bool isFull() const { return getCurrentSize() >= capacity; }
+};
+
+#endif
@@ -2,20 +2,23 @@
 #include <chrono>
 
 Device::Device(int id, double meanTime)
-  : deviceId(id), isBusy(false), meanServiceTime(meanTime), serviceStartTime(0.0), totalTimeBusy(0.0) {
+  : Device(id, std::make_shared<ExponentialDistribution>(meanTime)) {}
+
+Device::Device(int id, std::shared_ptr<const Distribution> serviceDistribution)
+  : deviceId(id), isBusy(false), distribution(*serviceDistribution), meanServiceTime(serviceDistribution->getMean()),
+  serviceStartTime(0), totalTimeBusy(0), online(true), retiring(false), onlineSince(0), totalTimeOnline(0) {
   unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
   generator.seed(seed + id);
-  distribution = std::exponential_distribution<double>(1.0 / meanServiceTime);
 }
 
-void Device::startService(const Request& req, double startTime) {
+void Device::startService(const Request& req, SimTime startTime) {
   isBusy = true;
   currentRequest = req;
   serviceStartTime = startTime;
   currentRequest.updateStatus(RequestStatus::PROCESSING);
 }
 
-void Device::completeService(double endTime) { //   
+void Device::completeService(SimTime endTime) { //   
   if (isBusy) {
     totalTimeBusy += (endTime - serviceStartTime); //  totalTimeBusy
   }
@@ -23,13 +26,58 @@ void Device::completeService(double endTime) { // 
   currentRequest.updateStatus(RequestStatus::COMPLETED);
 }
 
+void Device::interruptService(SimTime time) {
+  if (isBusy) {
+    totalTimeBusy += (time - serviceStartTime);
+  }
+  isBusy = false;
+}
+
 bool Device::isAvailable() const {
-  return !isBusy;
+  return !isBusy && online && !retiring;
+}
+
+void Device::bringOnline(SimTime time) {
+  if (!online) {
+    online = true;
+    onlineSince = time;
+  }
+  retiring = false;
+}
+
+void Device::takeOffline(SimTime time) {
+  if (online) {
+    totalTimeOnline += time - onlineSince;
+    online = false;
+  }
+  retiring = false;
+}
+
+SimTime Device::getTotalTimeOnline(SimTime now) const {
+  return totalTimeOnline + (online ? now - onlineSince : 0);
 }
 
 int Device::getDeviceId() const { return deviceId; }
 bool Device::getIsBusy() const { return isBusy; }
 const Request& Device::getCurrentRequest() const { return currentRequest; }
-double Device::getServiceStartTime() const { return serviceStartTime; }
-double Device::getTotalTimeBusy() const { return totalTimeBusy; }
-double Device::getServiceTime() { return distribution(generator); }
\ No newline at end of file
+SimTime Device::getServiceStartTime() const { return serviceStartTime; }
+SimTime Device::getTotalTimeBusy() const { return totalTimeBusy; }
+
+SimTime Device::getServiceTime() {
+  //         
+  if (currentRequest.hasPresetServiceTime()) {
+    return currentRequest.getPresetServiceTime();
+  }
+  //       ,     
+  const OwnedDistribution& byPriority = priorityDistributions[static_cast<int>(currentRequest.getPriority())];
+  return toSimTime(byPriority ? byPriority->sample(generator) : distribution->sample(generator));
+}
+
+void Device::setServiceDistribution(std::shared_ptr<const Distribution> serviceDistribution) {
+  distribution = OwnedDistribution(*serviceDistribution);
+  meanServiceTime = distribution->getMean();
+}
+
+void Device::setServiceDistribution(Priority p, std::shared_ptr<const Distribution> serviceDistribution) {
+  priorityDistributions[static_cast<int>(p)] = serviceDistribution ? OwnedDistribution(*serviceDistribution) : OwnedDistribution();
+}
@@ -2,8 +2,10 @@
 #define DEVICE_H
 
 #include "Request.h"
+#include "Distribution.h"
 #include <random>
 #include <chrono>
+#include <memory>
 
 class Device {
 private:
@@ -11,22 +13,46 @@ private:
   bool isBusy;
   Request currentRequest;
   std::default_random_engine generator;
-  std::exponential_distribution<double> distribution;
+  OwnedDistribution distribution;            //   
+  OwnedDistribution priorityDistributions[3]; //    
   double meanServiceTime;
-  double serviceStartTime;
-  double totalTimeBusy;
+  SimTime serviceStartTime;
+  SimTime totalTimeBusy;
+  bool online;            //    (  )
+  bool retiring;          //  :    ,     
+  SimTime onlineSince;     //    
+  SimTime totalTimeOnline; //      
 
 public:
   Device(int id, double meanTime);
-  void startService(const Request& req, double startTime);
-  void completeService(double endTime);
+  Device(int id, std::shared_ptr<const Distribution> serviceDistribution);
+  void startService(const Request& req, SimTime startTime);
+  void completeService(SimTime endTime);
+  //    :   ,  
+  void interruptService(SimTime time);
   bool isAvailable() const;
   int getDeviceId() const;
   bool getIsBusy() const;
   const Request& getCurrentRequest() const;
-  double getServiceStartTime() const;
-  double getTotalTimeBusy() const;
-  double getServiceTime();
+  SimTime getServiceStartTime() const;
+  SimTime getTotalTimeBusy() const;
+  SimTime getServiceTime();
+
+  //       ( )
+  void bringOnline(SimTime time);
+  void takeOffline(SimTime time);
+  void setRetiring(bool value) { retiring = value; }
+  bool isOnline() const { return online; }
+  bool isRetiring() const { return retiring; }
+  //      now (  )
+  SimTime getTotalTimeOnline(SimTime now) const;
+
+  //       ( )
+  void reseed(unsigned seed) { generator.seed(seed); }
+
+  //        (    )
+  void setServiceDistribution(std::shared_ptr<const Distribution> serviceDistribution);
+  void setServiceDistribution(Priority p, std::shared_ptr<const Distribution> serviceDistribution);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,7 +1,6 @@
 #include "Dispatcher.h"
 #include <algorithm>
 #include <stdexcept>
-#include <iostream>
 
 Dispatcher::Dispatcher(Buffer* buf, std::vector<Device*> devs)
   : buffer(buf), devices(devs), ringPointerBuffer(0), ringPointerDevice(0) {}
@@ -9,32 +8,24 @@ Dispatcher::Dispatcher(Buffer* buf, std::vector<Device*> devs)
 bool Dispatcher::acceptRequest(Request& req, Request& replacedReq) {
   // ,      
   if (!buffer->isFull()) {
-    addToBuffer(req);
-    return true;
-  }
-  else {
-    //  ,    D1004
-    bool added = buffer->addRequest(req, replacedReq);
-    if (added) {
-      return true;
-    }
-    else {
-      std::cout << ": buffer->addRequest  false     D1004." << std::endl;
-      return false;
-    }
+    return addToBuffer(req);
   }
+  //  ,    D1004.
+  //       
+  return buffer->addRequest(req, replacedReq);
 }
 
-void Dispatcher::addToBuffer(Request& req) {
+bool Dispatcher::addToBuffer(Request& req) {
   //       (D1031)
   Request dummyReplacedReq; //  ,  ,    
-  bool added = buffer->addRequest(req, dummyReplacedReq);
-  if (!added) {
-    std::cout << ": buffer->addRequest  false     ." << std::endl;
-  }
+  return buffer->addRequest(req, dummyReplacedReq);
+}
+
+bool Dispatcher::requeueRequest(const Request& req, Request& replacedReq) {
+  return buffer->reinsert(req, replacedReq);
 }
 
-AssignmentResult Dispatcher::assignToDevice(double currentTime) {
+AssignmentResult Dispatcher::assignToDevice(SimTime currentTime) {
   if (buffer->isEmpty()) {
     return AssignmentResult();
   }
@@ -46,70 +37,52 @@ AssignmentResult Dispatcher::assignToDevice(double currentTime) {
     return AssignmentResult();
   }
 
-  //      (D24)
-  Request selectedReq = selectRequestForService();
+  //      (D24)    
+  Request selectedReq;
+  takeRequest(selectedReq);
 
   //    
   selectedDevice->startService(selectedReq, currentTime);
 
-  //     -    
-  auto& slots = buffer->getSlots();
-  auto& occupied = buffer->getOccupancy();
-  for (size_t i = 0; i < slots.size(); ++i) {
-    if (occupied[i] && slots[i].getRequestId() == selectedReq.getRequestId()) {
-      buffer->markSlotFree(i);
+  return AssignmentResult(true, selectedReq.getRequestId(), selectedDevice->getDeviceId(), currentTime);
+}
+
+int Dispatcher::assignAll(SimTime currentTime, std::vector<AssignmentResult>& assignments) {
+  int assigned = 0;
+  // ,         
+  while (true) {
+    AssignmentResult result = assignToDevice(currentTime);
+    if (!result.success) {
       break;
     }
+    assignments.push_back(result);
+    ++assigned;
   }
-
-  return AssignmentResult(true, selectedReq.getRequestId(), selectedDevice->getDeviceId(), currentTime);
+  return assigned;
 }
 
 Request Dispatcher::selectRequestForService() {
-  // D24:     
-  //  (WARRANTY > CORPORATE > PRIVATE)
-
-  auto& slots = buffer->getSlots();
-  auto& occupied = buffer->getOccupancy();
-
-  const Request* maxReq = nullptr;
-  //          
-  double maxTimeEntered = -1.0;
-
-  for (size_t i = 0; i < slots.size(); ++i) {
-    //   
-    if (!occupied[i]) {
-      continue;
-    }
-    auto& slot = slots[i];
+  //     (  D24:  ,
+  //   -  ).     
+  int index = buffer->selectSlot();
+  if (index >= 0) {
+    return buffer->getSlots()[index];
+  }
 
-    bool shouldUpdate = false;
-    if (!maxReq) {
-      shouldUpdate = true;
-    }
-    else {
-      if (slot.getPriority() > maxReq->getPriority()) {
-        shouldUpdate = true;
-      }
-      else if (slot.getPriority() == maxReq->getPriority()) {
-        //   ,    timeEnteredBuffer
-        if (slot.getTimeEnteredBuffer() > maxTimeEntered) {
-          shouldUpdate = true;
-        }
-      }
-    }
+  throw std::runtime_error("     ,   .");
+}
 
-    if (shouldUpdate) {
-      maxReq = &slot;
-      maxTimeEntered = slot.getTimeEnteredBuffer(); //  
-    }
+bool Dispatcher::takeRequest(Request& out) {
+  int index = buffer->selectSlot();
+  if (index < 0) {
+    return false;
   }
 
-  if (maxReq) {
-    return *maxReq;
-  }
+  out = buffer->getSlots()[index];
 
-  throw std::runtime_error("     ,   .");
+  //     -    
+  buffer->markSlotFree(index);
+  return true;
 }
 
 Device* Dispatcher::selectFreeDevice() {
@@ -130,4 +103,13 @@ Device* Dispatcher::selectFreeDevice() {
   } while (ringPointerDevice != start);
 
   return nullptr;
-}
\ No newline at end of file
+}
+
+bool Dispatcher::hasFreeDevice() const {
+  for (const Device* device : devices) {
+    if (device->isAvailable()) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -11,10 +11,10 @@ struct AssignmentResult {
   bool success;
   int assignedRequestId;
   int assignedDeviceId;
-  double serviceStartTime;
+  SimTime serviceStartTime;
 
-  AssignmentResult() : success(false), assignedRequestId(-1), assignedDeviceId(-1), serviceStartTime(0.0) {}
-  AssignmentResult(bool s, int reqId, int devId, double time) : success(s), assignedRequestId(reqId), assignedDeviceId(devId), serviceStartTime(time) {}
+  AssignmentResult() : success(false), assignedRequestId(-1), assignedDeviceId(-1), serviceStartTime(0) {}
+  AssignmentResult(bool s, int reqId, int devId, SimTime time) : success(s), assignedRequestId(reqId), assignedDeviceId(devId), serviceStartTime(time) {}
 };
 
 class Dispatcher {
@@ -28,21 +28,41 @@ public:
   Dispatcher(Buffer* buf, std::vector<Device*> devs);
 
   //      
+  //  false,     
   bool acceptRequest(Request& req, Request& replacedReq);
 
   //       D1031
-  void addToBuffer(Request& req);
+  //  false,     
+  bool addToBuffer(Request& req);
+
+  //           
+  //  false,     
+  bool requeueRequest(const Request& req, Request& replacedReq);
 
   //       D2P2
   //   
-  AssignmentResult assignToDevice(double currentTime);
+  AssignmentResult assignToDevice(SimTime currentTime);
+
+  //            D2P2
+  //    assignments,   
+  int assignAll(SimTime currentTime, std::vector<AssignmentResult>& assignments);
 
   //         D24
   Request selectRequestForService();
 
-  //        D2P2
+  //        (D24 +  )
+  //  false,   
+  bool takeRequest(Request& out);
+
+  //        D2P2 (   )
   Device* selectFreeDevice();
 
+  //       (   )
+  bool hasFreeDevice() const;
+
+  //        (   )
+  void addDevice(Device* device) { devices.push_back(device); }
+
   Buffer* getBuffer() const { return buffer; }
   const std::vector<Device*>& getDevices() const { return devices; }
 
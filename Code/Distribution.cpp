@@ -0,0 +1,168 @@
+#include "Distribution.h"
+#include <cmath>
+#include <stdexcept>
+
+AliasTable::AliasTable(const std::vector<double>& weights) {
+  int n = static_cast<int>(weights.size());
+  if (n == 0) {
+    throw std::invalid_argument(" :   .");
+  }
+
+  double total = 0.0;
+  for (double w : weights) {
+    if (w < 0.0) {
+      throw std::invalid_argument(" :  .");
+    }
+    total += w;
+  }
+  if (total <= 0.0) {
+    throw std::invalid_argument(" :    .");
+  }
+
+  probability.assign(n, 1.0);
+  alias.resize(n);
+  for (int i = 0; i < n; ++i) {
+    alias[i] = i;
+  }
+
+  //  :     1    ""   ""
+  std::vector<double> scaled(n);
+  std::vector<int> small;
+  std::vector<int> large;
+  for (int i = 0; i < n; ++i) {
+    scaled[i] = weights[i] * n / total;
+    if (scaled[i] < 1.0) {
+      small.push_back(i);
+    }
+    else {
+      large.push_back(i);
+    }
+  }
+
+  while (!small.empty() && !large.empty()) {
+    int s = small.back();
+    small.pop_back();
+    int l = large.back();
+    probability[s] = scaled[s];
+    alias[s] = l;
+    scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+    if (scaled[l] < 1.0) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  //   (   )  
+  for (int i : small) {
+    probability[i] = 1.0;
+  }
+  for (int i : large) {
+    probability[i] = 1.0;
+  }
+  column = std::uniform_int_distribution<int>(0, n - 1);
+}
+
+int AliasTable::sample(std::default_random_engine& generator) const {
+  int i = column(generator);
+  return (coin(generator) < probability[i]) ? i : alias[i];
+}
+
+ExponentialDistribution::ExponentialDistribution(double meanValue) : mean(meanValue) {
+  if (mean <= 0.0) {
+    throw std::invalid_argument(" :    .");
+  }
+  exponential = std::exponential_distribution<double>(1.0 / mean);
+}
+
+double ExponentialDistribution::sample(std::default_random_engine& generator) const {
+  return exponential(generator);
+}
+
+UniformDistribution::UniformDistribution(double from, double to) : a(from), b(to) {
+  if (b < a) {
+    throw std::invalid_argument(" : b < a.");
+  }
+  uniform = std::uniform_real_distribution<double>(a, b);
+}
+
+double UniformDistribution::sample(std::default_random_engine& generator) const {
+  return uniform(generator);
+}
+
+ErlangDistribution::ErlangDistribution(int order, double meanValue) : k(order), mean(meanValue) {
+  if (k < 1 || mean <= 0.0) {
+    throw std::invalid_argument(" :  k >= 1   .");
+  }
+  //   k - -    
+  gamma = std::gamma_distribution<double>(k, mean / k);
+}
+
+double ErlangDistribution::sample(std::default_random_engine& generator) const {
+  return gamma(generator);
+}
+
+LognormalDistribution::LognormalDistribution(double meanValue, double stdDev) : mean(meanValue) {
+  if (mean <= 0.0 || stdDev < 0.0) {
+    throw std::invalid_argument(" :  .");
+  }
+  double sigma2 = std::log(1.0 + (stdDev * stdDev) / (mean * mean));
+  sigma = std::sqrt(sigma2);
+  mu = std::log(mean) - sigma2 / 2.0;
+  // std::lognormal_distribution  sigma > 0:   -  
+  if (sigma > 0.0) {
+    lognormal = std::lognormal_distribution<double>(mu, sigma);
+  }
+}
+
+double LognormalDistribution::sample(std::default_random_engine& generator) const {
+  if (sigma == 0.0) {
+    return mean;
+  }
+  return lognormal(generator);
+}
+
+HyperexponentialDistribution::HyperexponentialDistribution(const std::vector<double>& probabilities, const std::vector<double>& phaseMeans)
+  : phases(probabilities), mean(0.0) {
+  if (probabilities.size() != phaseMeans.size()) {
+    throw std::invalid_argument(" :      .");
+  }
+  double total = 0.0;
+  for (size_t i = 0; i < probabilities.size(); ++i) {
+    if (phaseMeans[i] <= 0.0) {
+      throw std::invalid_argument(" :     .");
+    }
+    total += probabilities[i];
+    mean += probabilities[i] * phaseMeans[i];
+    phaseDistributions.emplace_back(1.0 / phaseMeans[i]);
+  }
+  mean /= total;
+}
+
+double HyperexponentialDistribution::sample(std::default_random_engine& generator) const {
+  int phase = phases.sample(generator);
+  return phaseDistributions[phase](generator);
+}
+
+EmpiricalDistribution::EmpiricalDistribution(const std::vector<double>& binEdges, const std::vector<double>& counts)
+  : bins(counts), mean(0.0) {
+  if (binEdges.size() != counts.size() + 1) {
+    throw std::invalid_argument(" :      ,  .");
+  }
+  if (binEdges.front() < 0.0) {
+    throw std::invalid_argument(" :     .");
+  }
+  double total = 0.0;
+  for (size_t i = 0; i < counts.size(); ++i) {
+    if (!(binEdges[i + 1] > binEdges[i])) {
+      throw std::invalid_argument(" :     .");
+    }
+    total += counts[i];
+    mean += counts[i] * (binEdges[i] + binEdges[i + 1]) / 2.0;
+    binDistributions.emplace_back(binEdges[i], binEdges[i + 1]);
+  }
+  mean /= total;
+}
+
+double EmpiricalDistribution::sample(std::default_random_engine& generator) const {
+  int bin = bins.sample(generator);
+  return binDistributions[bin](generator);
+}
@@ -0,0 +1,152 @@
+#ifndef DISTRIBUTION_H
+#define DISTRIBUTION_H
+
+#include <random>
+#include <vector>
+#include <memory>
+
+//      (     ).
+//          (, 
+//  ),         .
+//     - :       
+class Distribution {
+public:
+  virtual ~Distribution() {}
+
+  //     
+  virtual double sample(std::default_random_engine& generator) const = 0;
+
+  //   
+  virtual double getMean() const = 0;
+
+  //     
+  virtual std::unique_ptr<Distribution> clone() const = 0;
+};
+
+//       .
+//      ,      
+class OwnedDistribution {
+private:
+  std::unique_ptr<Distribution> instance;
+
+public:
+  OwnedDistribution() {}
+  explicit OwnedDistribution(const Distribution& prototype) : instance(prototype.clone()) {}
+  OwnedDistribution(const OwnedDistribution& other) : instance(other.instance ? other.instance->clone() : nullptr) {}
+  OwnedDistribution(OwnedDistribution&& other) = default;
+  OwnedDistribution& operator=(const OwnedDistribution& other) {
+    instance = other.instance ? other.instance->clone() : nullptr;
+    return *this;
+  }
+  OwnedDistribution& operator=(OwnedDistribution&& other) = default;
+
+  explicit operator bool() const { return static_cast<bool>(instance); }
+  const Distribution* operator->() const { return instance.get(); }
+};
+
+//   ( ):     O(1)
+class AliasTable {
+private:
+  std::vector<double> probability; //     
+  std::vector<int> alias;          // - 
+  mutable std::uniform_int_distribution<int> column;
+  mutable std::uniform_real_distribution<double> coin;
+
+public:
+  AliasTable() {}
+  AliasTable(const std::vector<double>& weights);
+
+  //       
+  int sample(std::default_random_engine& generator) const;
+
+  int size() const { return static_cast<int>(probability.size()); }
+};
+
+//   (   )
+class ExponentialDistribution : public Distribution {
+private:
+  double mean;
+  mutable std::exponential_distribution<double> exponential;
+
+public:
+  ExponentialDistribution(double meanValue);
+  double sample(std::default_random_engine& generator) const override;
+  double getMean() const override { return mean; }
+  std::unique_ptr<Distribution> clone() const override { return std::unique_ptr<Distribution>(new ExponentialDistribution(*this)); }
+};
+
+//    [a, b] (   )
+class UniformDistribution : public Distribution {
+private:
+  double a;
+  double b;
+  mutable std::uniform_real_distribution<double> uniform;
+
+public:
+  UniformDistribution(double from, double to);
+  double sample(std::default_random_engine& generator) const override;
+  double getMean() const override { return (a + b) / 2.0; }
+  std::unique_ptr<Distribution> clone() const override { return std::unique_ptr<Distribution>(new UniformDistribution(*this)); }
+};
+
+//    k   
+class ErlangDistribution : public Distribution {
+private:
+  int k;
+  double mean;
+  mutable std::gamma_distribution<double> gamma;
+
+public:
+  ErlangDistribution(int order, double meanValue);
+  double sample(std::default_random_engine& generator) const override;
+  double getMean() const override { return mean; }
+  std::unique_ptr<Distribution> clone() const override { return std::unique_ptr<Distribution>(new ErlangDistribution(*this)); }
+};
+
+//  ,       .
+//        
+class LognormalDistribution : public Distribution {
+private:
+  double mean;
+  double mu;    //    
+  double sigma;
+  mutable std::lognormal_distribution<double> lognormal;
+
+public:
+  LognormalDistribution(double meanValue, double stdDev);
+  double sample(std::default_random_engine& generator) const override;
+  double getMean() const override { return mean; }
+  std::unique_ptr<Distribution> clone() const override { return std::unique_ptr<Distribution>(new LognormalDistribution(*this)); }
+};
+
+//  :  ,     
+class HyperexponentialDistribution : public Distribution {
+private:
+  AliasTable phases;
+  double mean;
+  mutable std::vector<std::exponential_distribution<double>> phaseDistributions; //   
+
+public:
+  HyperexponentialDistribution(const std::vector<double>& probabilities, const std::vector<double>& phaseMeans);
+  double sample(std::default_random_engine& generator) const override;
+  double getMean() const override { return mean; }
+  std::unique_ptr<Distribution> clone() const override { return std::unique_ptr<Distribution>(new HyperexponentialDistribution(*this)); }
+};
+
+//    :       O(1),
+//    - . binEdges     ,  counts,
+//     
+class EmpiricalDistribution : public Distribution {
+private:
+  AliasTable bins;
+  double mean;
+  mutable std::vector<std::uniform_real_distribution<double>> binDistributions; //    
+
+public:
+  EmpiricalDistribution(const std::vector<double>& binEdges, const std::vector<double>& counts);
+  double sample(std::default_random_engine& generator) const override;
+  double getMean() const override { return mean; }
+  std::unique_ptr<Distribution> clone() const override { return std::unique_ptr<Distribution>(new EmpiricalDistribution(*this)); }
+};
+
+#endif
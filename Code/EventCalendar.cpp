@@ -0,0 +1,138 @@
+#include "EventCalendar.h"
+
+const char* eventTypeToString(EventType type) {
+  switch (type) {
+  case EventType::GENERATION: return "GENERATION";
+  case EventType::SERVICE_COMPLETE: return "SERVICE_COMPLETE";
+  case EventType::DEVICE_ONLINE: return "DEVICE_ONLINE";
+  case EventType::SCALING_CHECK: return "SCALING_CHECK";
+  default: return "?";
+  }
+}
+
+bool EventCalendar::less(int slotA, int slotB) const {
+  const Slot& a = slots[slotA];
+  const Slot& b = slots[slotB];
+  if (a.event.time != b.event.time) {
+    return a.event.time < b.event.time;
+  }
+  return a.seq < b.seq;
+}
+
+void EventCalendar::place(int heapIndex, int slot) {
+  heap[heapIndex] = slot;
+  slots[slot].heapIndex = heapIndex;
+}
+
+void EventCalendar::siftUp(int heapIndex) {
+  int slot = heap[heapIndex];
+  while (heapIndex > 0) {
+    int parent = (heapIndex - 1) / 2;
+    if (!less(slot, heap[parent])) {
+      break;
+    }
+    place(heapIndex, heap[parent]);
+    heapIndex = parent;
+  }
+  place(heapIndex, slot);
+}
+
+void EventCalendar::siftDown(int heapIndex) {
+  int slot = heap[heapIndex];
+  int count = static_cast<int>(heap.size());
+  while (true) {
+    int child = 2 * heapIndex + 1;
+    if (child >= count) {
+      break;
+    }
+    if (child + 1 < count && less(heap[child + 1], heap[child])) {
+      ++child;
+    }
+    if (!less(heap[child], slot)) {
+      break;
+    }
+    place(heapIndex, heap[child]);
+    heapIndex = child;
+  }
+  place(heapIndex, slot);
+}
+
+EventHandle EventCalendar::push(const Event& event) {
+  int slot;
+  if (!freeSlots.empty()) {
+    slot = freeSlots.back();
+    freeSlots.pop_back();
+    slots[slot].event = event;
+  }
+  else {
+    slot = static_cast<int>(slots.size());
+    slots.push_back(Slot{ event, 0, -1, 0 });
+  }
+  slots[slot].seq = nextSeq++;
+
+  heap.push_back(slot);
+  siftUp(static_cast<int>(heap.size()) - 1);
+  return EventHandle(slot, slots[slot].generation);
+}
+
+void EventCalendar::removeAt(int heapIndex) {
+  int slot = heap[heapIndex];
+  slots[slot].heapIndex = -1;
+  slots[slot].generation++;
+  freeSlots.push_back(slot);
+
+  int last = heap.back();
+  heap.pop_back();
+  if (heapIndex < static_cast<int>(heap.size())) {
+    //            
+    place(heapIndex, last);
+    siftUp(heapIndex);
+    siftDown(slots[last].heapIndex);
+  }
+}
+
+bool EventCalendar::contains(const EventHandle& handle) const {
+  return handle.slot >= 0 && handle.slot < static_cast<int>(slots.size()) &&
+    slots[handle.slot].generation == handle.generation && slots[handle.slot].heapIndex >= 0;
+}
+
+bool EventCalendar::cancel(const EventHandle& handle) {
+  if (!contains(handle)) {
+    return false;
+  }
+  removeAt(slots[handle.slot].heapIndex);
+  return true;
+}
+
+bool EventCalendar::reschedule(const EventHandle& handle, SimTime newTime) {
+  if (!contains(handle)) {
+    return false;
+  }
+  Slot& s = slots[handle.slot];
+  s.event.time = newTime;
+  s.seq = nextSeq++;
+  siftUp(s.heapIndex);
+  siftDown(s.heapIndex);
+  return true;
+}
+
+bool EventCalendar::isConsistent() const {
+  int count = static_cast<int>(heap.size());
+  if (count + freeSlots.size() != slots.size()) {
+    return false;
+  }
+  for (int i = 0; i < count; ++i) {
+    if (slots[heap[i]].heapIndex != i) {
+      return false;
+    }
+    if (i > 0 && less(heap[i], heap[(i - 1) / 2])) {
+      return false;
+    }
+  }
+  for (int slot : freeSlots) {
+    if (slots[slot].heapIndex != -1) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,99 @@
+#ifndef EVENTCALENDAR_H
+#define EVENTCALENDAR_H
+
+#include "Request.h"
+#include <vector>
+
+//   
+enum class EventType {
+  GENERATION,        //    
+  SERVICE_COMPLETE,  //    
+  DEVICE_ONLINE,     //     
+  SCALING_CHECK      //   
+};
+
+//       (1)
+const char* eventTypeToString(EventType type);
+
+struct Event {
+  SimTime time;         //  
+  EventType type;       //  
+  int sourceId;         // ID  ( GENERATION)
+  int deviceId;         // ID  ( SERVICE_COMPLETE, DEVICE_ONLINE)
+  int requestId;        // ID 
+  Request request;      //   ( GENERATION)
+
+  //    
+  Event(SimTime t, EventType ty, int srcId, int reqId, const Request& req)
+    : time(t), type(ty), sourceId(srcId), deviceId(-1), requestId(reqId), request(req) {}
+
+  //       
+  Event(SimTime t, EventType ty, int devId, int reqId)
+    : time(t), type(ty), sourceId(-1), deviceId(devId), requestId(reqId) {}
+
+  //      (  -  )
+  bool operator>(const Event& other) const {
+    return time > other.time;
+  }
+};
+
+//     
+struct EventHandle {
+  int slot;
+  unsigned generation;
+
+  EventHandle() : slot(-1), generation(0) {}
+  EventHandle(int s, unsigned g) : slot(s), generation(g) {}
+};
+
+//      .
+//  push/top/pop/empty   std::priority_queue;  push 
+// ,       O(log n).
+//        
+class EventCalendar {
+private:
+  struct Slot {
+    Event event;
+    unsigned long long seq;  //    (  )
+    int heapIndex;           //   , -1 -  
+    unsigned generation;     //    
+  };
+
+  std::vector<Slot> slots;
+  std::vector<int> heap;      //     
+  std::vector<int> freeSlots;
+  unsigned long long nextSeq;
+
+  bool less(int slotA, int slotB) const;
+  void place(int heapIndex, int slot);
+  void siftUp(int heapIndex);
+  void siftDown(int heapIndex);
+  void removeAt(int heapIndex);
+
+public:
+  EventCalendar() : nextSeq(0) {}
+
+  EventHandle push(const Event& event);
+  const Event& top() const { return slots[heap.front()].event; }
+  void pop() { removeAt(0); }
+  bool empty() const { return heap.empty(); }
+  size_t size() const { return heap.size(); }
+
+  //   ,      
+  bool contains(const EventHandle& handle) const;
+
+  //       
+  const Event& get(const EventHandle& handle) const { return slots[handle.slot].event; }
+
+  //    .  false,      
+  bool cancel(const EventHandle& handle);
+
+  //       newTime  O(log n).     
+  //     .  false,   
+  bool reschedule(const EventHandle& handle, SimTime newTime);
+
+  //          ( )
+  bool isConsistent() const;
+};
+
+#endif
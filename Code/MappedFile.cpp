@@ -0,0 +1,110 @@
+#include "MappedFile.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& filePath)
+  : path(filePath), data(nullptr), length(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {
+  fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (fileHandle == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("    : " + path);
+  }
+  LARGE_INTEGER fileSize;
+  GetFileSizeEx(fileHandle, &fileSize);
+  length = static_cast<size_t>(fileSize.QuadPart);
+  if (length == 0) {
+    return;
+  }
+  mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mappingHandle) {
+    CloseHandle(fileHandle);
+    throw std::runtime_error("    : " + path);
+  }
+  data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+  if (!data) {
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    throw std::runtime_error("    : " + path);
+  }
+}
+
+MappedFile::~MappedFile() {
+  if (data) {
+    UnmapViewOfFile(data);
+  }
+  if (mappingHandle) {
+    CloseHandle(mappingHandle);
+  }
+  if (fileHandle != INVALID_HANDLE_VALUE) {
+    CloseHandle(fileHandle);
+  }
+}
+
+void MappedFile::prefetch(size_t offset, size_t count) const {
+  if (offset >= length) {
+    return;
+  }
+  WIN32_MEMORY_RANGE_ENTRY range;
+  range.VirtualAddress = const_cast<char*>(data + offset);
+  range.NumberOfBytes = (count < length - offset) ? count : length - offset;
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& filePath)
+  : path(filePath), data(nullptr), length(0), fd(-1) {
+  fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("    : " + path);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    throw std::runtime_error("     : " + path);
+  }
+  length = static_cast<size_t>(st.st_size);
+  if (length == 0) {
+    return;
+  }
+  void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (mapped == MAP_FAILED) {
+    close(fd);
+    throw std::runtime_error("    : " + path);
+  }
+  data = static_cast<const char*>(mapped);
+  //    -     
+  madvise(mapped, length, MADV_SEQUENTIAL);
+}
+
+MappedFile::~MappedFile() {
+  if (data) {
+    munmap(const_cast<char*>(data), length);
+  }
+  if (fd >= 0) {
+    close(fd);
+  }
+}
+
+void MappedFile::prefetch(size_t offset, size_t count) const {
+  if (offset >= length) {
+    return;
+  }
+  // madvise  ,   
+  static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t alignedOffset = offset - offset % pageSize;
+  size_t alignedCount = ((count < length - offset) ? count : length - offset) + (offset - alignedOffset);
+  madvise(const_cast<char*>(data + alignedOffset), alignedCount, MADV_WILLNEED);
+}
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+// ,      .     ,
+//     
+class MappedFile {
+private:
+  std::string path;
+  const char* data;
+  size_t length;
+#ifdef _WIN32
+  void* fileHandle;
+  void* mappingHandle;
+#else
+  int fd;
+#endif
+
+public:
+  MappedFile(const std::string& filePath);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  //    :      
+  void prefetch(size_t offset, size_t count) const;
+
+  const char* begin() const { return data; }
+  const char* end() const { return data + length; }
+  size_t size() const { return length; }
+  const std::string& getPath() const { return path; }
+};
+
+#endif
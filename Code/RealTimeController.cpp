@@ -0,0 +1,253 @@
+#include "RealTimeController.h"
+#include <thread>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+RealTimeConfig::RealTimeConfig()
+  : bufferSize(5), durationSeconds(5.0), meanServiceMicros(0.0) {
+  int hw = static_cast<int>(std::thread::hardware_concurrency());
+  producerCount = std::max(1, hw / 2);
+  deviceCount = std::max(1, hw - producerCount);
+}
+
+namespace {
+
+//          count  otherCount
+void mergeMoments(double& mean, double& sumSqDiff, long long count, double otherMean, double otherSumSqDiff, long long otherCount) {
+  long long total = count + otherCount;
+  if (otherCount == 0 || total == 0) {
+    return;
+  }
+  double delta = otherMean - mean;
+  mean += delta * otherCount / total;
+  sumSqDiff += otherSumSqDiff + delta * delta * (static_cast<double>(count) * otherCount / total);
+}
+
+}
+
+RealTimeSourceStats::RealTimeSourceStats()
+  : generated(0), rejected(0), completed(0), sumTimeInSystem(0.0),
+  meanWaiting(0.0), sumSqDiffWaiting(0.0), meanProcessing(0.0), sumSqDiffProcessing(0.0) {}
+
+void RealTimeSourceStats::addCompleted(double timeInSystem, double waiting, double processing) {
+  completed++;
+  sumTimeInSystem += timeInSystem;
+
+  double oldMean = meanWaiting;
+  meanWaiting += (waiting - oldMean) / completed;
+  sumSqDiffWaiting += (waiting - oldMean) * (waiting - meanWaiting);
+
+  oldMean = meanProcessing;
+  meanProcessing += (processing - oldMean) / completed;
+  sumSqDiffProcessing += (processing - oldMean) * (processing - meanProcessing);
+}
+
+void RealTimeSourceStats::merge(const RealTimeSourceStats& other) {
+  mergeMoments(meanWaiting, sumSqDiffWaiting, completed, other.meanWaiting, other.sumSqDiffWaiting, other.completed);
+  mergeMoments(meanProcessing, sumSqDiffProcessing, completed, other.meanProcessing, other.sumSqDiffProcessing, other.completed);
+  generated += other.generated;
+  rejected += other.rejected;
+  completed += other.completed;
+  sumTimeInSystem += other.sumTimeInSystem;
+}
+
+RealTimeController::RealTimeController(const RealTimeConfig& cfg)
+  : config(cfg),
+  buffer(cfg.bufferSize),
+  idleWorkers(0),
+  running(false),
+  producersStopped(false),
+  elapsedSeconds(0.0) {
+
+  //   ,    
+  sources.emplace_back(1, 10.0, Priority::WARRANTY);
+  sources.emplace_back(2, 7.0, Priority::CORPORATE);
+  sources.emplace_back(3, 5.0, Priority::PRIVATE);
+
+  //       
+  double deviceMean = (config.meanServiceMicros > 0.0) ? config.meanServiceMicros : 1.0;
+  for (int i = 1; i <= config.deviceCount; ++i) {
+    devices.emplace_back(i, deviceMean);
+  }
+
+  producerStats.assign(config.producerCount, std::vector<RealTimeSourceStats>(sources.size() + 1));
+  workerStats.assign(config.deviceCount, std::vector<RealTimeSourceStats>(sources.size() + 1));
+}
+
+double RealTimeController::now() const {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void RealTimeController::run() {
+  startTime = std::chrono::steady_clock::now();
+  running = true;
+  producersStopped = false;
+
+  std::vector<std::thread> workers;
+  for (int i = 0; i < config.deviceCount; ++i) {
+    workers.emplace_back(&RealTimeController::workerLoop, this, i);
+  }
+  std::vector<std::thread> producers;
+  for (int i = 0; i < config.producerCount; ++i) {
+    producers.emplace_back(&RealTimeController::producerLoop, this, i);
+  }
+
+  std::this_thread::sleep_for(std::chrono::duration<double>(config.durationSeconds));
+  running = false;
+
+  for (auto& t : producers) {
+    t.join();
+  }
+  //         running,  
+  //     .   ,
+  //      
+  {
+    std::lock_guard<std::mutex> lock(idleMutex);
+    producersStopped = true;
+  }
+  bufferNotEmpty.notify_all();
+  for (auto& t : workers) {
+    t.join();
+  }
+
+  elapsedSeconds = now();
+}
+
+void RealTimeController::producerLoop(int producerIndex) {
+  //       ,
+  //         
+  std::vector<Source> localSources = sources;
+  std::vector<RealTimeSourceStats>& stats = producerStats[producerIndex];
+
+  // ID    ,    
+  int requestId = producerIndex + 1;
+  size_t next = producerIndex % localSources.size();
+
+  while (running.load(std::memory_order_relaxed)) {
+    Source& source = localSources[next];
+    next = (next + 1) % localSources.size();
+
+    double t = now();
+    Request req = source.generateRequest(toSimTime(t), requestId);
+    req.setTimeEnteredBuffer(toSimTime(t));
+    requestId += config.producerCount;
+
+    Request replacedReq;
+    buffer.addRequest(req, replacedReq); // D1031,   - D1004
+    if (idleWorkers.load(std::memory_order_acquire) > 0) {
+      {
+        std::lock_guard<std::mutex> lock(idleMutex);
+      }
+      bufferNotEmpty.notify_one();
+    }
+
+    stats[source.getSourceId()].generated++;
+    if (replacedReq.getStatus() == RequestStatus::REJECTED) {
+      stats[replacedReq.getSourceId()].rejected++;
+    }
+  }
+}
+
+void RealTimeController::workerLoop(int deviceIndex) {
+  Device& device = devices[deviceIndex];
+  std::vector<RealTimeSourceStats>& stats = workerStats[deviceIndex];
+  Request req;
+
+  while (true) {
+    // D24:     
+    int spins = 0;
+    while (!buffer.takeRequest(req)) {
+      if (producersStopped.load(std::memory_order_acquire) && buffer.isEmpty()) {
+        return; //  ,  
+      }
+      if (++spins < 64) {
+        std::this_thread::yield();
+        continue;
+      }
+      //   -    .    ,
+      //          
+      std::unique_lock<std::mutex> lock(idleMutex);
+      idleWorkers.fetch_add(1, std::memory_order_acq_rel);
+      if (buffer.isEmpty() && !producersStopped.load(std::memory_order_acquire)) {
+        bufferNotEmpty.wait_for(lock, std::chrono::milliseconds(1));
+      }
+      idleWorkers.fetch_sub(1, std::memory_order_acq_rel);
+      spins = 0;
+    }
+
+    double serviceStart = now();
+    device.startService(req, toSimTime(serviceStart));
+    if (config.meanServiceMicros > 0.0) {
+      //   :     
+      double serviceEnd = serviceStart + fromSimTime(device.getServiceTime()) * 1e-6;
+      while (now() < serviceEnd) {
+      }
+    }
+    double serviceEnd = now();
+    device.completeService(toSimTime(serviceEnd));
+
+    double waitTime = serviceStart - fromSimTime(req.getCreationTime());
+    double serviceDuration = serviceEnd - serviceStart;
+    stats[req.getSourceId()].addCompleted(serviceEnd - fromSimTime(req.getCreationTime()), waitTime, serviceDuration);
+  }
+}
+
+std::vector<RealTimeSourceStats> RealTimeController::getSourceStats() const {
+  std::vector<RealTimeSourceStats> total(sources.size() + 1);
+  for (const auto& perThread : producerStats) {
+    for (size_t i = 0; i < perThread.size(); ++i) total[i].merge(perThread[i]);
+  }
+  for (const auto& perThread : workerStats) {
+    for (size_t i = 0; i < perThread.size(); ++i) total[i].merge(perThread[i]);
+  }
+  return total;
+}
+
+void RealTimeController::printSummary() {
+  std::vector<RealTimeSourceStats> total = getSourceStats();
+
+  long long generated = 0;
+  long long completed = 0;
+  for (const auto& s : total) {
+    generated += s.generated;
+    completed += s.completed;
+  }
+
+  std::cout << "\n---------------   (  ) ---------------\n" << std::endl;
+  std::cout << ": " << config.producerCount << ", : " << config.deviceCount
+    << ", : " << std::fixed << std::setprecision(3) << elapsedSeconds << " " << std::endl;
+  std::cout << " : " << std::setprecision(0) << generated / elapsedSeconds << " / (), "
+    << completed / elapsedSeconds << " / ()" << std::endl;
+  std::cout << std::endl;
+
+  //    
+  std::cout << " 1:    (  )." << std::endl;
+  std::cout << std::setw(10) << "   " << std::setw(15) << " " << std::setw(15) << "P" << std::setw(15) << "T" << std::setw(15) << "T" << std::setw(15) << "T" << std::setw(15) << "" << std::setw(15) << "" << std::endl;
+
+  for (size_t i = 1; i < total.size(); ++i) {
+    const RealTimeSourceStats& s = total[i];
+    double n = static_cast<double>(s.completed);
+    double p_otk = (s.generated > 0) ? static_cast<double>(s.rejected) / s.generated : 0.0;
+    double t_pr = (s.completed > 0) ? s.sumTimeInSystem / n * 1e6 : 0.0;
+    double t_bp = s.meanWaiting * 1e6;
+    double t_obsl = s.meanProcessing * 1e6;
+    double d_bp = s.waitingVariance() * 1e12;
+    double d_obsl = s.processingVariance() * 1e12;
+
+    std::cout << std::setw(10) << "" << i << std::setw(15) << s.generated << std::setw(15) << std::fixed << std::setprecision(4) << p_otk
+      << std::setw(15) << t_pr << std::setw(15) << t_bp << std::setw(15) << t_obsl
+      << std::setw(15) << d_bp << std::setw(15) << d_obsl << std::endl;
+  }
+  std::cout << std::endl;
+
+  std::cout << " 2:   ." << std::endl;
+  std::cout << std::setw(10) << "   " << std::setw(25) << " " << std::endl;
+
+  for (const Device& dev : devices) {
+    double k_isp = fromSimTime(dev.getTotalTimeBusy()) / elapsedSeconds;
+    std::cout << std::setw(10) << "" << dev.getDeviceId() << std::setw(25) << std::fixed << std::setprecision(4) << k_isp << std::endl;
+  }
+
+  std::cout << "\n-----------------------------------------------------------------\n" << std::endl;
+}
@@ -0,0 +1,93 @@
+#ifndef REALTIMECONTROLLER_H
+#define REALTIMECONTROLLER_H
+
+#include "Source.h"
+#include "ConcurrentBuffer.h"
+#include "Device.h"
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+//    
+struct RealTimeConfig {
+  int producerCount;        //  - 
+  int deviceCount;          //   ( )
+  int bufferSize;           //  
+  double durationSeconds;   //      
+  double meanServiceMicros; //      (0 -  )
+
+  RealTimeConfig();
+};
+
+//    .     ,
+//     .
+//        ,    :
+//    ,        
+struct RealTimeSourceStats {
+  long long generated;
+  long long rejected;
+  long long completed;
+  double sumTimeInSystem;
+  double meanWaiting;
+  double sumSqDiffWaiting;     //      ()
+  double meanProcessing;
+  double sumSqDiffProcessing;
+
+  RealTimeSourceStats();
+
+  //     
+  void addCompleted(double timeInSystem, double waiting, double processing);
+
+  //        (     )
+  void merge(const RealTimeSourceStats& other);
+
+  //    (0      )
+  double waitingVariance() const { return (completed > 1) ? sumSqDiffWaiting / (completed - 1) : 0.0; }
+  double processingVariance() const { return (completed > 1) ? sumSqDiffProcessing / (completed - 1) : 0.0; }
+};
+
+class RealTimeController {
+private:
+  RealTimeConfig config;
+  std::vector<Source> sources;      //   (    )
+  ConcurrentBuffer buffer;          //  ( D1031/D1004/D24   )
+  std::vector<Device> devices;      // ,    
+
+  std::mutex idleMutex;                   //      
+  std::condition_variable bufferNotEmpty; //    
+  std::atomic<int> idleWorkers;           //  ,  
+  std::atomic<bool> running;             //   
+  std::atomic<bool> producersStopped;     //  :     
+
+  std::chrono::steady_clock::time_point startTime;
+  double elapsedSeconds;
+
+  //  : [][ID ]
+  std::vector<std::vector<RealTimeSourceStats>> producerStats;
+  std::vector<std::vector<RealTimeSourceStats>> workerStats;
+
+  //      
+  double now() const;
+
+  void producerLoop(int producerIndex);
+  void workerLoop(int deviceIndex);
+
+public:
+  RealTimeController(const RealTimeConfig& cfg);
+
+  //      config.durationSeconds
+  void run();
+
+  //   ,     ( - ID , 0  )
+  std::vector<RealTimeSourceStats> getSourceStats() const;
+
+  //      
+  double getElapsedSeconds() const { return elapsedSeconds; }
+
+  //      1
+  void printSummary();
+};
+
+#endif
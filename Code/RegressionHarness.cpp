@@ -0,0 +1,559 @@
+#include "RegressionHarness.h"
+#include "Statistics.h"
+#include "ArrivalProfile.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cctype>
+#include <ctime>
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace {
+
+//   : 17     double
+std::string exactValue(double value) {
+  std::ostringstream stream;
+  stream << std::setprecision(17) << value;
+  return stream.str();
+}
+
+//       .   :     ,
+//    ,       
+std::string numericCells(const std::string& text) {
+  std::string cells;
+  size_t i = 0;
+  while (i < text.size()) {
+    bool negative = text[i] == '-' && i + 1 < text.size() && std::isdigit(static_cast<unsigned char>(text[i + 1]));
+    if (!negative && !std::isdigit(static_cast<unsigned char>(text[i]))) {
+      ++i;
+      continue;
+    }
+    size_t start = i++;
+    while (i < text.size() && (std::isdigit(static_cast<unsigned char>(text[i])) || text[i] == '.')) {
+      ++i;
+    }
+    if (!cells.empty()) {
+      cells += ' ';
+    }
+    cells.append(text, start, i - start);
+  }
+  return cells;
+}
+
+// FNV-1a (64 ) 
+std::string textHash(const std::string& text) {
+  unsigned long long hash = 14695981039346656037ULL;
+  for (unsigned char c : text) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  std::ostringstream stream;
+  stream << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return stream.str();
+}
+
+const char* historyHeader = "timestamp,case,time_base,events,seconds,events_per_sec,rss_growth_kb,golden";
+
+double median(std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  size_t n = values.size();
+  return (n % 2 == 1) ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+}
+
+}
+
+RegressionHarness::RegressionHarness(const std::string& goldenFile, const std::string& historyFile)
+  : goldenPath(goldenFile), historyPath(historyFile), catalogue(defaultCatalogue()),
+  slowdownTolerance(0.15), memoryTolerance(0.25), memorySlackKb(1024), historyWindow(5), timingRepeats(3), memorySampleEvents(5000) {}
+
+const char* RegressionHarness::timeBaseName() {
+#ifdef SERVICE_CENTER_TICK_TIME
+  return "ticks";
+#else
+  return "double";
+#endif
+}
+
+long RegressionHarness::currentResidentSetKb() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return 0;
+  }
+  return static_cast<long>(counters.WorkingSetSize / 1024);
+#elif defined(__APPLE__)
+  mach_task_basic_info info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+    return 0;
+  }
+  return static_cast<long>(info.resident_size / 1024);
+#else
+  //   statm -  
+  std::ifstream statm("/proc/self/statm");
+  long totalPages = 0;
+  long residentPages = 0;
+  if (!(statm >> totalPages >> residentPages)) {
+    return 0;
+  }
+  return residentPages * (sysconf(_SC_PAGESIZE) / 1024);
+#endif
+}
+
+long RegressionHarness::residentSetBaselineKb() {
+#ifdef __GLIBC__
+  //  ,   ,      
+  malloc_trim(0);
+#endif
+  return currentResidentSetKb();
+}
+
+std::vector<RegressionCase> RegressionHarness::defaultCatalogue() {
+  std::vector<RegressionCase> cases;
+
+  SimulationConfig base;
+  base.simulationEndTime = 200000.0; //   0.1 :  -  /  
+  base.seed = 101;
+  cases.emplace_back("default", base);
+
+  SimulationConfig largeBuffer = base;
+  largeBuffer.bufferSize = 20;
+  largeBuffer.deviceCount = 4;
+  largeBuffer.seed = 102;
+  cases.emplace_back("large_buffer", largeBuffer);
+
+  SimulationConfig preemptive = base;
+  preemptive.preemption = PreemptionMode::RESUME;
+  preemptive.seed = 103;
+  cases.emplace_back("preempt_resume", preemptive);
+
+  SimulationConfig edf = base;
+  edf.bufferSize = 10;
+  edf.selection.discipline = SelectionDiscipline::EDF;
+  edf.seed = 104;
+  cases.emplace_back("edf", edf);
+
+  SimulationConfig aging = base;
+  aging.bufferSize = 10;
+  aging.selection.discipline = SelectionDiscipline::AGING;
+  aging.seed = 105;
+  cases.emplace_back("aging", aging);
+
+  SimulationConfig autoscale = base;
+  autoscale.scaling.enabled = true;
+  autoscale.scaling.minDevices = 1;
+  autoscale.scaling.maxDevices = 8;
+  autoscale.seed = 106;
+  cases.emplace_back("autoscale", autoscale);
+
+  //    :  200,     
+  SimulationConfig daily = base;
+  daily.sources[2].arrivalProfile = std::make_shared<ArrivalProfile>(
+    std::vector<double>{ 0.0, 50.0, 100.0, 150.0 }, std::vector<double>{ 0.1, 0.3, 0.3, 0.1 },
+    ProfileShape::PIECEWISE_LINEAR, 200.0);
+  daily.seed = 107;
+  cases.emplace_back("daily_profile", daily);
+
+  //      10
+  SimulationConfig hyperexp = base;
+  hyperexp.serviceDistribution = std::make_shared<HyperexponentialDistribution>(
+    std::vector<double>{ 0.9, 0.1 }, std::vector<double>{ 5.0, 55.0 });
+  hyperexp.seed = 108;
+  cases.emplace_back("hyperexp_service", hyperexp);
+
+  //  :        
+  SimulationConfig statistical;
+  statistical.simulationEndTime = 50000.0;
+  cases.emplace_back("default_stat", statistical, 10);
+
+  SimulationConfig autoscaleStat = statistical;
+  autoscaleStat.scaling = autoscale.scaling;
+  cases.emplace_back("autoscale_stat", autoscaleStat, 10);
+
+  return cases;
+}
+
+void RegressionHarness::runTimed(SimulationController& controller, RegressionOutcome& outcome) {
+  auto started = std::chrono::steady_clock::now();
+  controller.runToCompletion();
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+  double rate = (seconds > 0.0) ? controller.getEventsProcessed() / seconds : 0.0;
+  if (outcome.seconds == 0.0 || rate > outcome.eventsPerSecond) {
+    outcome.events = controller.getEventsProcessed();
+    outcome.seconds = seconds;
+    outcome.eventsPerSecond = rate;
+  }
+}
+
+void RegressionHarness::runSampled(SimulationController& controller, long baselineKb, RegressionOutcome& outcome) const {
+  long peakKb = currentResidentSetKb();
+  while (controller.runForEvents(memorySampleEvents) > 0) {
+    peakKb = std::max(peakKb, currentResidentSetKb());
+  }
+  outcome.rssGrowthKb = std::max(0L, peakKb - baselineKb);
+}
+
+RegressionHarness::MetricSet RegressionHarness::runCase(const RegressionCase& regressionCase, RegressionOutcome& outcome) const {
+  MetricSet metrics;
+  outcome.name = regressionCase.name;
+
+  if (regressionCase.replications <= 1) {
+    //    -   ,  -      seed
+    long baselineKb = residentSetBaselineKb();
+    SimulationController controller(regressionCase.config);
+    std::ostringstream summary;
+    controller.setOutput(summary);
+    runSampled(controller, baselineKb, outcome);
+
+    for (int repeat = 0; repeat < timingRepeats; ++repeat) {
+      SimulationController timingController(regressionCase.config);
+      runTimed(timingController, outcome);
+    }
+
+    SimulationResults results = controller.getResults();
+    for (const SourceResults& s : results.sources) {
+      std::string prefix = "source" + std::to_string(s.sourceId) + ".";
+      metrics[prefix + "generated"].exact = std::to_string(s.generated);
+      metrics[prefix + "rejected"].exact = std::to_string(s.rejected);
+      metrics[prefix + "completed"].exact = std::to_string(s.completed);
+      metrics[prefix + "rejection"].exact = exactValue(s.rejectionProbability);
+      metrics[prefix + "time_in_system"].exact = exactValue(s.meanTimeInSystem);
+      metrics[prefix + "waiting"].exact = exactValue(s.meanWaiting);
+      metrics[prefix + "processing"].exact = exactValue(s.meanProcessing);
+      metrics[prefix + "p99_waiting"].exact = exactValue(s.p99Waiting);
+      metrics[prefix + "deadline_miss"].exact = exactValue(s.deadlineMissRate);
+    }
+    for (size_t i = 0; i < results.deviceUtilization.size(); ++i) {
+      metrics["device" + std::to_string(i + 1) + ".utilization"].exact = exactValue(results.deviceUtilization[i]);
+    }
+    metrics["p99_waiting"].exact = exactValue(results.p99Waiting);
+    metrics["mean_online_devices"].exact = exactValue(results.meanOnlineDevices);
+    metrics["scale_ups"].exact = std::to_string(results.scaleUps);
+    metrics["scale_downs"].exact = std::to_string(results.scaleDowns);
+    metrics["events"].exact = std::to_string(controller.getEventsProcessed());
+
+    //     ,     getResults (,   )
+    controller.printSummary();
+    metrics["summary_hash"].exact = textHash(numericCells(summary.str()));
+  }
+  else {
+    std::random_device entropy;
+    std::map<std::string, std::vector<double>> samples;
+    for (int r = 0; r < regressionCase.replications; ++r) {
+      SimulationConfig config = regressionCase.config;
+      config.seed = entropy();
+      if (config.seed == 0) {
+        config.seed = 1; // 0     
+      }
+      //    ,  - 
+      long baselineKb = (r == 0) ? residentSetBaselineKb() : 0;
+      SimulationController controller(config);
+      if (r == 0) {
+        runSampled(controller, baselineKb, outcome);
+      }
+      else {
+        runTimed(controller, outcome);
+      }
+
+      SimulationResults results = controller.getResults();
+      for (const SourceResults& s : results.sources) {
+        std::string prefix = "source" + std::to_string(s.sourceId) + ".";
+        samples[prefix + "rejection"].push_back(s.rejectionProbability);
+        samples[prefix + "waiting"].push_back(s.meanWaiting);
+      }
+      samples["mean_utilization"].push_back(sampleMean(results.deviceUtilization));
+    }
+    for (const auto& entry : samples) {
+      Metric& metric = metrics[entry.first];
+      metric.mean = sampleMean(entry.second);
+      metric.halfWidth = confidenceHalfWidth(entry.second);
+    }
+  }
+
+  return metrics;
+}
+
+RegressionHarness::GoldenSections RegressionHarness::readGoldenSections() const {
+  GoldenSections sections;
+  std::ifstream file(goldenPath);
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(file, line)) {
+    ++lineNumber;
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back(); //        Windows
+    }
+    std::istringstream fields(line);
+    std::string first;
+    if (!(fields >> first)) {
+      continue;
+    }
+    if (first == "timebase") {
+      std::string timeBase;
+      fields >> timeBase;
+      sections.emplace_back(timeBase, std::vector<std::string>());
+    }
+    else if (sections.empty()) {
+      throw std::runtime_error("     " + std::to_string(lineNumber) + ":   timebase");
+    }
+    else {
+      sections.back().second.push_back(line);
+    }
+  }
+  return sections;
+}
+
+std::map<std::string, RegressionHarness::MetricSet> RegressionHarness::loadGolden() const {
+  if (!std::ifstream(goldenPath)) {
+    throw std::runtime_error("    : " + goldenPath);
+  }
+
+  GoldenSections sections = readGoldenSections();
+  auto section = std::find_if(sections.begin(), sections.end(),
+    [](const GoldenSections::value_type& s) { return s.first == timeBaseName(); });
+  //          
+  if (section == sections.end()) {
+    throw std::runtime_error("       '" + std::string(timeBaseName()) + "'");
+  }
+
+  std::map<std::string, MetricSet> golden;
+  for (const std::string& line : section->second) {
+    std::istringstream fields(line);
+    std::string caseName;
+    std::string metricName;
+    std::string kind;
+    Metric metric;
+    bool valid = static_cast<bool>(fields >> caseName >> metricName >> kind);
+    if (valid && kind == "=") {
+      valid = static_cast<bool>(fields >> metric.exact);
+    }
+    else if (valid && kind == "~") {
+      valid = static_cast<bool>(fields >> metric.mean >> metric.halfWidth);
+    }
+    else {
+      valid = false;
+    }
+    if (!valid) {
+      throw std::runtime_error("  : " + line);
+    }
+    golden[caseName][metricName] = metric;
+  }
+  return golden;
+}
+
+void RegressionHarness::compare(const MetricSet& golden, const MetricSet& current, RegressionOutcome& outcome) const {
+  outcome.passed = true;
+  for (const auto& entry : golden) {
+    auto found = current.find(entry.first);
+    if (found == current.end()) {
+      outcome.passed = false;
+      outcome.detail = entry.first + ":    ";
+      return;
+    }
+
+    const Metric& expected = entry.second;
+    const Metric& actual = found->second;
+    if (!expected.exact.empty()) {
+      if (expected.exact != actual.exact) {
+        outcome.passed = false;
+        outcome.detail = entry.first + ": " + expected.exact + " -> " + actual.exact;
+        return;
+      }
+    }
+    else {
+      //     ;  1.5   
+      double allowed = 1.5 * std::sqrt(expected.halfWidth * expected.halfWidth + actual.halfWidth * actual.halfWidth);
+      if (std::fabs(actual.mean - expected.mean) > allowed + 1e-12) {
+        std::ostringstream detail;
+        detail << entry.first << ": " << expected.mean << " -> " << actual.mean << " ( " << allowed << ")";
+        outcome.passed = false;
+        outcome.detail = detail.str();
+        return;
+      }
+    }
+  }
+  if (golden.size() != current.size()) {
+    outcome.passed = false;
+    outcome.detail = "  ";
+  }
+}
+
+void RegressionHarness::checkHistory(RegressionOutcome& outcome) const {
+  std::ifstream file(historyPath);
+  if (!file) {
+    return; //   
+  }
+
+  std::vector<double> rates;
+  std::vector<double> memory;
+  std::string line;
+  std::getline(file, line);
+  if (!line.empty() && line.back() == '\r') {
+    line.pop_back();
+  }
+  if (line != historyHeader) {
+    return; //        
+  }
+  while (std::getline(file, line)) {
+    std::vector<std::string> fields;
+    std::istringstream row(line);
+    std::string field;
+    while (std::getline(row, field, ',')) {
+      fields.push_back(field);
+    }
+    if (fields.size() < 7 || fields[1] != outcome.name || fields[2] != timeBaseName()) {
+      continue;
+    }
+    rates.push_back(std::stod(fields[5]));
+    memory.push_back(std::stod(fields[6]));
+  }
+  if (rates.empty()) {
+    return;
+  }
+
+  size_t first = (rates.size() > static_cast<size_t>(historyWindow)) ? rates.size() - historyWindow : 0;
+  double typicalRate = median(std::vector<double>(rates.begin() + first, rates.end()));
+  double typicalMemory = median(std::vector<double>(memory.begin() + first, memory.end()));
+  outcome.slower = outcome.eventsPerSecond < (1.0 - slowdownTolerance) * typicalRate;
+  outcome.heavier = outcome.rssGrowthKb > (1.0 + memoryTolerance) * typicalMemory + memorySlackKb;
+}
+
+void RegressionHarness::appendHistory() const {
+  bool exists = static_cast<bool>(std::ifstream(historyPath));
+  std::ofstream file(historyPath, std::ios::app);
+  if (!file) {
+    throw std::runtime_error("    : " + historyPath);
+  }
+  if (!exists) {
+    file << historyHeader << std::endl;
+  }
+
+  long long timestamp = static_cast<long long>(std::time(nullptr));
+  for (const RegressionOutcome& outcome : outcomes) {
+    const char* goldenStatus = !outcome.hasGolden ? "none" : (outcome.passed ? "pass" : "fail");
+    file << timestamp << ',' << outcome.name << ',' << timeBaseName() << ',' << outcome.events << ','
+      << std::setprecision(6) << outcome.seconds << ',' << std::setprecision(10) << outcome.eventsPerSecond << ','
+      << outcome.rssGrowthKb << ',' << goldenStatus << std::endl;
+  }
+}
+
+void RegressionHarness::recordGolden() {
+  outcomes.clear();
+  GoldenSections sections = readGoldenSections();
+
+  std::vector<std::string> section;
+  for (const RegressionCase& regressionCase : catalogue) {
+    RegressionOutcome outcome;
+    MetricSet metrics = runCase(regressionCase, outcome);
+    for (const auto& entry : metrics) {
+      std::ostringstream line;
+      line << regressionCase.name << ' ' << entry.first;
+      if (regressionCase.replications <= 1) {
+        line << " = " << entry.second.exact;
+      }
+      else {
+        line << " ~ " << std::setprecision(17) << entry.second.mean << ' ' << entry.second.halfWidth;
+      }
+      section.push_back(line.str());
+    }
+    outcome.hasGolden = true;
+    outcome.passed = true;
+    outcome.detail = " ";
+    checkHistory(outcome);
+    outcomes.push_back(outcome);
+  }
+
+  //     ,    
+  auto current = std::find_if(sections.begin(), sections.end(),
+    [](const GoldenSections::value_type& s) { return s.first == timeBaseName(); });
+  if (current != sections.end()) {
+    current->second = section;
+  }
+  else {
+    sections.emplace_back(timeBaseName(), section);
+  }
+
+  std::ofstream file(goldenPath);
+  if (!file) {
+    throw std::runtime_error("    : " + goldenPath);
+  }
+  for (const auto& entry : sections) {
+    file << "timebase " << entry.first << std::endl;
+    for (const std::string& line : entry.second) {
+      file << line << std::endl;
+    }
+  }
+  appendHistory();
+}
+
+bool RegressionHarness::check() {
+  outcomes.clear();
+  std::map<std::string, MetricSet> golden = loadGolden();
+
+  bool allPassed = true;
+  for (const RegressionCase& regressionCase : catalogue) {
+    RegressionOutcome outcome;
+    MetricSet metrics = runCase(regressionCase, outcome);
+    auto found = golden.find(regressionCase.name);
+    if (found == golden.end()) {
+      outcome.detail = " ";
+    }
+    else {
+      outcome.hasGolden = true;
+      compare(found->second, metrics, outcome);
+    }
+    checkHistory(outcome);
+    allPassed = allPassed && outcome.hasGolden && outcome.passed;
+    outcomes.push_back(outcome);
+  }
+  appendHistory();
+  return allPassed;
+}
+
+bool RegressionHarness::hasPerformanceRegression() const {
+  for (const RegressionOutcome& outcome : outcomes) {
+    if (outcome.slower || outcome.heavier) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void RegressionHarness::printReport(std::ostream& out) const {
+  out << "\n---------------   (: " << timeBaseName() << ") ---------------\n" << std::endl;
+  out << std::left << std::setw(20) << "" << std::right << std::setw(10) << ""
+    << std::setw(12) << "" << std::setw(14) << "/" << std::setw(16) << " RSS, " << "  " << std::endl;
+
+  for (const RegressionOutcome& outcome : outcomes) {
+    const char* status = !outcome.hasGolden ? "" : (outcome.passed ? "OK" : "");
+    std::string notes = outcome.detail;
+    if (outcome.slower) {
+      notes += (notes.empty() ? "" : "; ") + std::string(" ");
+    }
+    if (outcome.heavier) {
+      notes += (notes.empty() ? "" : "; ") + std::string("  ");
+    }
+    out << std::left << std::setw(20) << outcome.name << std::right << std::setw(10) << status
+      << std::setw(12) << outcome.events << std::setw(14) << std::fixed << std::setprecision(0) << outcome.eventsPerSecond
+      << std::setw(16) << outcome.rssGrowthKb << "  " << notes << std::endl;
+  }
+  out << "\n-----------------------------------------------------------------\n" << std::endl;
+}
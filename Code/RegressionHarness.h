@@ -0,0 +1,117 @@
+#ifndef REGRESSIONHARNESS_H
+#define REGRESSIONHARNESS_H
+
+#include "SimulationController.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <iostream>
+
+//     
+struct RegressionCase {
+  std::string name;
+  SimulationConfig config;
+  // 1 -    config.seed,      .
+  //  1 -     ,     
+  int replications;
+
+  RegressionCase(const std::string& caseName, const SimulationConfig& caseConfig, int caseReplications = 1)
+    : name(caseName), config(caseConfig), replications(caseReplications) {}
+};
+
+//    
+struct RegressionOutcome {
+  std::string name;
+  bool hasGolden;         //    
+  bool passed;            //    
+  std::string detail;     //  
+  //   -     :       
+  long long events;       //     
+  double seconds;         //     
+  double eventsPerSecond; // events / seconds
+  long rssGrowthKb;       //   RSS      
+  bool slower;            // /  ,   
+  bool heavier;           //  RSS  ,   
+
+  RegressionOutcome()
+    : hasGolden(false), passed(false), events(0), seconds(0.0), eventsPerSecond(0.0), rssGrowthKb(0), slower(false), heavier(false) {}
+};
+
+//  :    ,   
+//    .
+//
+//  -       :  "timebase double"  "timebase ticks",
+//     , "<> <> = <>" ()  "... ~ <> < >".
+//       .    Code/golden_results.txt,
+//  11    Code.
+//  - CSV,       ;  /    RSS
+//       .
+//        : RSS   memorySampleEvents ,
+//            
+class RegressionHarness {
+private:
+  // :   ( )     95% 
+  struct Metric {
+    std::string exact;
+    double mean;
+    double halfWidth;
+
+    Metric() : mean(0.0), halfWidth(0.0) {}
+  };
+  typedef std::map<std::string, Metric> MetricSet;
+
+  std::string goldenPath;
+  std::string historyPath;
+  std::vector<RegressionCase> catalogue;
+  std::vector<RegressionOutcome> outcomes;
+  double slowdownTolerance; //   /    ()
+  double memoryTolerance;   //    RSS ()
+  long memorySlackKb;       //  : RSS      
+  int historyWindow;        //    
+  int timingRepeats;        //      
+  long long memorySampleEvents; //    RSS
+
+  //      ;     outcome
+  static void runTimed(SimulationController& controller, RegressionOutcome& outcome);
+  //      RSS;   baselineKb   outcome
+  void runSampled(SimulationController& controller, long baselineKb, RegressionOutcome& outcome) const;
+
+  MetricSet runCase(const RegressionCase& regressionCase, RegressionOutcome& outcome) const;
+  //   :      ( ,   )
+  typedef std::vector<std::pair<std::string, std::vector<std::string>>> GoldenSections;
+  GoldenSections readGoldenSections() const;
+  //    
+  std::map<std::string, MetricSet> loadGolden() const;
+  void compare(const MetricSet& golden, const MetricSet& current, RegressionOutcome& outcome) const;
+  void checkHistory(RegressionOutcome& outcome) const;
+  void appendHistory() const;
+
+public:
+  RegressionHarness(const std::string& goldenFile, const std::string& historyFile);
+
+  //   
+  static std::vector<RegressionCase> defaultCatalogue();
+
+  //        (  )
+  void recordGolden();
+
+  //     .  true,       
+  bool check();
+
+  // true,       .     ,
+  //    check()     
+  bool hasPerformanceRegression() const;
+
+  void printReport(std::ostream& out = std::cout) const;
+
+  //       (0,  )
+  static long currentResidentSetKb();
+  //      ( )   RSS -   
+  static long residentSetBaselineKb();
+
+  //     
+  static const char* timeBaseName();
+};
+
+#endif
@@ -2,17 +2,20 @@
 #include <sstream>
 
 Request::Request()
-  : requestId(0), sourceId(0), creationTime(0.0), timeEnteredBuffer(0.0), priority(Priority::PRIVATE), status(RequestStatus::NEW) {
-  description = "  ";
-}
+  : requestId(0), sourceId(0), creationTime(0), timeEnteredBuffer(0), priority(Priority::PRIVATE), status(RequestStatus::NEW), presetServiceTime(-1), accumulatedServiceTime(0) {}
+
+Request::Request(int reqId, int srcId, SimTime time, Priority pri)
+  : requestId(reqId), sourceId(srcId), creationTime(time), timeEnteredBuffer(0),
+  priority(pri), status(RequestStatus::NEW), presetServiceTime(-1), accumulatedServiceTime(0) {}
 
-Request::Request(int reqId, int srcId, double time, Priority pri)
-  : requestId(reqId), sourceId(srcId), creationTime(time), timeEnteredBuffer(0.0),
-  priority(pri), status(RequestStatus::NEW) {
+std::string Request::getDescription() const {
+  if (requestId == 0) {
+    return "  ";
+  }
   std::ostringstream oss;
-  oss << " #" << requestId << "   " << srcId
+  oss << " #" << requestId << "   " << sourceId
     << " (: " << priorityToString(priority) << ")";
-  description = oss.str();
+  return oss.str();
 }
 
 std::string Request::getIdString() const {
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <iostream>
+#include "SimTime.h"
 
 enum class Priority {
   PRIVATE,       //  ()
@@ -22,24 +23,26 @@ class Request {
 private:
   int requestId;        //  ID 
   int sourceId;         // ID ,   
-  double creationTime;  //   
-  double timeEnteredBuffer; // ,     
+  SimTime creationTime;  //   
+  SimTime timeEnteredBuffer; // ,     
   Priority priority;    //  
   RequestStatus status; // C 
-  std::string description; // 
+  SimTime presetServiceTime; //  ,   (), < 0 -  
+  SimTime accumulatedServiceTime; //      
 
 public:
   Request();
 
-  Request(int reqId, int srcId, double time, Priority pri);
+  Request(int reqId, int srcId, SimTime time, Priority pri);
 
   int getRequestId() const { return requestId; }
   int getSourceId() const { return sourceId; }
-  double getCreationTime() const { return creationTime; }
-  double getTimeEnteredBuffer() const { return timeEnteredBuffer; }
+  SimTime getCreationTime() const { return creationTime; }
+  SimTime getTimeEnteredBuffer() const { return timeEnteredBuffer; }
   Priority getPriority() const { return priority; }
   RequestStatus getStatus() const { return status; }
-  std::string getDescription() const { return description; }
+  //    ,      
+  std::string getDescription() const;
 
   //      ID 
   std::string getIdString() const;
@@ -48,7 +51,16 @@ public:
   void updateStatus(RequestStatus newStatus) { status = newStatus; }
 
   //       
-  void setTimeEnteredBuffer(double time) { timeEnteredBuffer = time; }
+  void setTimeEnteredBuffer(SimTime time) { timeEnteredBuffer = time; }
+
+  //    ,   (,   )
+  bool hasPresetServiceTime() const { return presetServiceTime >= 0; }
+  SimTime getPresetServiceTime() const { return presetServiceTime; }
+  void setPresetServiceTime(SimTime time) { presetServiceTime = time; }
+
+  //    ,     
+  SimTime getAccumulatedServiceTime() const { return accumulatedServiceTime; }
+  void addAccumulatedServiceTime(SimTime time) { accumulatedServiceTime += time; }
 
   //       
   static std::string priorityToString(Priority p);
@@ -0,0 +1,39 @@
+#include "ScalingPolicy.h"
+#include <stdexcept>
+
+ScalingPolicy::ScalingPolicy()
+  : enabled(false), evaluationInterval(10.0), scaleUpOccupancy(0.6), scaleUpRejection(0.05),
+  scaleDownOccupancy(0.1), scaleDownRejection(0.01), minDevices(1), maxDevices(10),
+  startupDelay(10.0), cooldown(20.0) {}
+
+void ScalingPolicy::validate() const {
+  if (evaluationInterval <= 0.0 || startupDelay < 0.0 || cooldown < 0.0) {
+    throw std::invalid_argument(" :     ,  - .");
+  }
+  if (minDevices < 1 || maxDevices < minDevices) {
+    throw std::invalid_argument(" :   1 <= minDevices <= maxDevices.");
+  }
+  //          
+  if (scaleDownOccupancy >= scaleUpOccupancy || scaleDownRejection >= scaleUpRejection) {
+    throw std::invalid_argument(" :       .");
+  }
+}
+
+ScalingAction ScalingPolicy::decide(const ScalingObservation& observation, double lastActionTime) const {
+  if (observation.time - lastActionTime < cooldown) {
+    return ScalingAction::NONE;
+  }
+
+  int activeDevices = observation.onlineDevices + observation.startingDevices;
+  bool overloaded = observation.meanOccupancy >= scaleUpOccupancy || observation.rejectionRate >= scaleUpRejection;
+  if (overloaded) {
+    return (activeDevices < maxDevices) ? ScalingAction::SCALE_UP : ScalingAction::NONE;
+  }
+
+  //       ,      
+  bool underloaded = observation.meanOccupancy <= scaleDownOccupancy && observation.rejectionRate <= scaleDownRejection;
+  if (underloaded && observation.startingDevices == 0 && observation.onlineDevices > minDevices) {
+    return ScalingAction::SCALE_DOWN;
+  }
+  return ScalingAction::NONE;
+}
@@ -0,0 +1,43 @@
+#ifndef SCALINGPOLICY_H
+#define SCALINGPOLICY_H
+
+//   
+enum class ScalingAction {
+  NONE,
+  SCALE_UP,   //     (     )
+  SCALE_DOWN  //    ( - ,  -   )
+};
+
+//      
+struct ScalingObservation {
+  double time;           //  
+  double meanOccupancy;  //       
+  double rejectionRate;  //       
+  int onlineDevices;     //   ,  
+  int startingDevices;   // ,    
+};
+
+//     .    
+//    ,         
+struct ScalingPolicy {
+  bool enabled;
+  double evaluationInterval; //   
+  double scaleUpOccupancy;   //  ,      ...
+  double scaleUpRejection;   // ...     
+  double scaleDownOccupancy; //  ,      
+  double scaleDownRejection; //      
+  int minDevices;
+  int maxDevices;
+  double startupDelay;       //      
+  double cooldown;           //   ,       
+
+  ScalingPolicy();
+
+  //   ,  std::invalid_argument
+  void validate() const;
+
+  //   ; lastActionTime -   
+  ScalingAction decide(const ScalingObservation& observation, double lastActionTime) const;
+};
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef SERVICECENTER_H
+#define SERVICECENTER_H
+
+//       .
+//
+// :
+//   SimulationConfig config;
+//   config.deviceCount = 4;
+//   config.seed = 42;
+//   SimulationController model(config);
+//   model.runUntil(500.0);        //  runForEvents(n), runToCompletion()
+//   SimulationResults r = model.getResults();
+//
+//              ,
+//     print*.     
+//   ;       .
+//      -  getCancellationToken().cancel().
+
+#include "SimulationController.h"
+#include "Distribution.h"
+
+#endif
@@ -0,0 +1,313 @@
+#include "ShardedSimulation.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include <map>
+
+ShardedConfig::ShardedConfig()
+  : shardCount(4), policy(RoutingPolicy::POWER_OF_D), choices(2) {}
+
+namespace {
+
+//      
+struct MergedSource {
+  int generated;
+  int rejected;
+  int completed;
+  double sumTimeInSystem;
+  double sumWaiting;
+  double sumProcessing;
+  int deadlineMisses;
+  std::vector<SourceResults> parts; //     
+
+  MergedSource() : generated(0), rejected(0), completed(0), sumTimeInSystem(0.0), sumWaiting(0.0), sumProcessing(0.0), deadlineMisses(0) {}
+
+  void add(const SourceResults& s) {
+    generated += s.generated;
+    rejected += s.rejected;
+    completed += s.completed;
+    sumTimeInSystem += s.meanTimeInSystem * s.completed;
+    sumWaiting += s.meanWaiting * s.completed;
+    sumProcessing += s.meanProcessing * s.completed;
+    deadlineMisses += static_cast<int>(s.deadlineMissRate * s.completed + 0.5);
+    parts.push_back(s);
+  }
+
+  //         
+  double pooledVariance(double SourceResults::* mean, double SourceResults::* variance) const {
+    if (completed < 2) {
+      return 0.0;
+    }
+    double total = 0.0;
+    for (const SourceResults& s : parts) {
+      total += s.*mean * s.completed;
+    }
+    double grandMean = total / completed;
+    double sumSq = 0.0;
+    for (const SourceResults& s : parts) {
+      double shift = s.*mean - grandMean;
+      sumSq += (s.completed > 1 ? (s.completed - 1) * (s.*variance) : 0.0) + s.completed * shift * shift;
+    }
+    return sumSq / (completed - 1);
+  }
+};
+
+}
+
+ShardedSimulation::ShardedSimulation(const ShardedConfig& cfg)
+  : config(cfg), roundRobinPointer(0), currentTime(0), simulationEndTime(toSimTime(cfg.shard.simulationEndTime)), nextRequestId(1) {
+  if (config.shardCount < 1) {
+    throw std::invalid_argument("    .");
+  }
+  if (config.policy == RoutingPolicy::POWER_OF_D && config.choices < 1) {
+    throw std::invalid_argument("    d  d >= 1.");
+  }
+
+  unsigned seed = config.shard.seed;
+  if (seed == 0) {
+    seed = static_cast<unsigned>(std::chrono::system_clock::now().time_since_epoch().count());
+  }
+  routerGenerator.seed(seed);
+
+  //    seed,     :  j  k
+  //  seed + k * stride + 1000 + j,     
+  int stride = config.shard.deviceCount;
+  if (config.shard.scaling.enabled) {
+    stride = std::max(stride, config.shard.scaling.maxDevices);
+  }
+  for (int k = 0; k < config.shardCount; ++k) {
+    SimulationConfig shardConfig = config.shard;
+    shardConfig.seed = seed + static_cast<unsigned>(k * stride);
+    shardConfig.externalArrivals = true;
+    shards.emplace_back(new SimulationController(shardConfig));
+  }
+
+  //   :        (   )
+  int sourceCount = static_cast<int>(config.shard.sources.size());
+  for (int k = 0; k < config.shardCount; ++k) {
+    for (int i = 0; i < sourceCount; ++i) {
+      const SourceConfig& sc = config.shard.sources[i];
+      sources.emplace_back(i + 1, sc.interval, sc.priority);
+      if (sc.intervalDistribution) {
+        sources.back().setIntervalDistribution(sc.intervalDistribution);
+      }
+      if (sc.arrivalProfile) {
+        sources.back().setArrivalProfile(sc.arrivalProfile);
+      }
+      sources.back().reseed(seed + static_cast<unsigned>(k * sourceCount + i + 1));
+    }
+  }
+
+  for (size_t i = 0; i < sources.size(); ++i) {
+    scheduleGeneration(static_cast<int>(i));
+  }
+  for (int k = 0; k < config.shardCount; ++k) {
+    trackShard(k); //        
+  }
+}
+
+const char* ShardedSimulation::policyToString(RoutingPolicy policy) {
+  switch (policy) {
+  case RoutingPolicy::RANDOM: return "";
+  case RoutingPolicy::ROUND_ROBIN: return " ";
+  case RoutingPolicy::JOIN_SHORTEST_QUEUE: return " ";
+  case RoutingPolicy::POWER_OF_D: return "  d";
+  default: return "";
+  }
+}
+
+void ShardedSimulation::scheduleGeneration(int streamIndex) {
+  Source& source = sources[streamIndex];
+  SimTime nextGenTime = source.getNextGenerationTime(currentTime);
+  if (nextGenTime == simTimeInfinity()) {
+    return; //     
+  }
+  Request nextRequest = source.generateRequest(nextGenTime, nextRequestId++);
+  nextRequest.setTimeEnteredBuffer(nextGenTime);
+  arrivals.push(Event(nextGenTime, EventType::GENERATION, streamIndex + 1, nextRequest.getRequestId(), nextRequest));
+}
+
+void ShardedSimulation::trackShard(int shardIndex) {
+  SimTime next = shards[shardIndex]->getNextEventTime();
+  if (next != simTimeInfinity()) {
+    shardEvents.push(ShardEntry(next, shardIndex));
+  }
+}
+
+int ShardedSimulation::nextShard() {
+  while (!shardEvents.empty()) {
+    const ShardEntry& top = shardEvents.top();
+    if (shards[top.second]->getNextEventTime() == top.first) {
+      return top.second;
+    }
+    shardEvents.pop(); //      
+  }
+  return -1;
+}
+
+int ShardedSimulation::routeArrival() {
+  int k = config.shardCount;
+  switch (config.policy) {
+  case RoutingPolicy::RANDOM:
+    return std::uniform_int_distribution<int>(0, k - 1)(routerGenerator);
+  case RoutingPolicy::ROUND_ROBIN: {
+    int shard = roundRobinPointer;
+    roundRobinPointer = (roundRobinPointer + 1) % k;
+    return shard;
+  }
+  case RoutingPolicy::JOIN_SHORTEST_QUEUE: {
+    int best = 0;
+    for (int i = 1; i < k; ++i) {
+      if (shards[i]->getRequestsInSystem() < shards[best]->getRequestsInSystem()) {
+        best = i;
+      }
+    }
+    return best;
+  }
+  case RoutingPolicy::POWER_OF_D:
+  default: {
+    //   d ,     K
+    std::uniform_int_distribution<int> pick(0, k - 1);
+    int best = pick(routerGenerator);
+    for (int i = 1; i < config.choices; ++i) {
+      int candidate = pick(routerGenerator);
+      if (shards[candidate]->getRequestsInSystem() < shards[best]->getRequestsInSystem()) {
+        best = candidate;
+      }
+    }
+    return best;
+  }
+  }
+}
+
+bool ShardedSimulation::stepSimulation() {
+  SimTime arrivalTime = arrivals.empty() ? simTimeInfinity() : arrivals.top().time;
+  int shardIndex = nextShard();
+  SimTime shardTime = (shardIndex >= 0) ? shardEvents.top().first : simTimeInfinity();
+
+  if (std::min(arrivalTime, shardTime) > simulationEndTime) {
+    //       
+    for (auto& shard : shards) {
+      shard->runToCompletion();
+    }
+    return false;
+  }
+
+  if (shardTime <= arrivalTime) {
+    //   ( ,    ,  ) 
+    //     ,      
+    shardEvents.pop();
+    currentTime = shardTime;
+    shards[shardIndex]->stepSimulationBatch();
+    trackShard(shardIndex);
+    return true;
+  }
+
+  Event arrival = arrivals.top();
+  arrivals.pop();
+  currentTime = arrival.time;
+
+  //           
+  int target = routeArrival();
+  shards[target]->submitArrival(arrival.request);
+  shards[target]->stepSimulationBatch();
+  trackShard(target);
+
+  scheduleGeneration(arrival.sourceId - 1);
+  return true;
+}
+
+void ShardedSimulation::runToCompletion() {
+  while (stepSimulation()) {
+  }
+}
+
+void ShardedSimulation::printSummary() {
+  const SimulationConfig& shardConfig = config.shard;
+  std::cout << "\n---------------   (: " << policyToString(config.policy) << ") ---------------\n" << std::endl;
+
+  std::cout << " 1:  ." << std::endl;
+  std::cout << std::setw(10) << "   " << std::setw(15) << "" << std::setw(15) << "P" << std::setw(15) << "T"
+    << std::setw(15) << "T" << std::setw(15) << "";
+  if (shardConfig.scaling.enabled) {
+    std::cout << std::setw(20) << "  ";
+  }
+  std::cout << std::endl;
+
+  std::map<int, MergedSource> total;
+  int preemptions = 0;
+  int scaleUps = 0;
+  int scaleDowns = 0;
+  double onlineDevices = 0.0;
+  for (size_t k = 0; k < shards.size(); ++k) {
+    SimulationResults results = shards[k]->getResults();
+    MergedSource shardTotal;
+    for (const SourceResults& s : results.sources) {
+      shardTotal.add(s);
+      total[s.sourceId].add(s);
+    }
+    preemptions += results.preemptions;
+    scaleUps += results.scaleUps;
+    scaleDowns += results.scaleDowns;
+    onlineDevices += results.meanOnlineDevices;
+
+    double utilization = 0.0;
+    for (double u : results.deviceUtilization) {
+      utilization += u;
+    }
+    double k_isp = results.deviceUtilization.empty() ? 0.0 : utilization / results.deviceUtilization.size();
+    double p_otk = (shardTotal.generated > 0) ? static_cast<double>(shardTotal.rejected) / shardTotal.generated : 0.0;
+    double t_pr = (shardTotal.completed > 0) ? shardTotal.sumTimeInSystem / shardTotal.completed : 0.0;
+    double t_bp = (shardTotal.completed > 0) ? shardTotal.sumWaiting / shardTotal.completed : 0.0;
+
+    std::cout << std::setw(10) << "" << k + 1 << std::setw(15) << shardTotal.generated << std::setw(15) << std::fixed << std::setprecision(4) << p_otk
+      << std::setw(15) << t_pr << std::setw(15) << t_bp << std::setw(15) << k_isp;
+    if (shardConfig.scaling.enabled) {
+      std::cout << std::setw(20) << results.meanOnlineDevices;
+    }
+    std::cout << std::endl;
+  }
+  std::cout << std::endl;
+
+  std::cout << " 2:     ." << std::endl;
+  std::cout << std::setw(10) << "   " << std::setw(15) << " " << std::setw(15) << "P" << std::setw(15) << "T"
+    << std::setw(15) << "T" << std::setw(15) << "T" << std::setw(15) << "" << std::setw(15) << "" << std::endl;
+  for (const auto& entry : total) {
+    const MergedSource& s = entry.second;
+    double p_otk = (s.generated > 0) ? static_cast<double>(s.rejected) / s.generated : 0.0;
+    double t_pr = (s.completed > 0) ? s.sumTimeInSystem / s.completed : 0.0;
+    double t_bp = (s.completed > 0) ? s.sumWaiting / s.completed : 0.0;
+    double t_obsl = (s.completed > 0) ? s.sumProcessing / s.completed : 0.0;
+    double d_bp = s.pooledVariance(&SourceResults::meanWaiting, &SourceResults::waitingVariance);
+    double d_obsl = s.pooledVariance(&SourceResults::meanProcessing, &SourceResults::processingVariance);
+    std::cout << std::setw(10) << "" << entry.first << std::setw(15) << s.generated << std::setw(15) << std::fixed << std::setprecision(4) << p_otk
+      << std::setw(15) << t_pr << std::setw(15) << t_bp << std::setw(15) << t_obsl
+      << std::setw(15) << d_bp << std::setw(15) << d_obsl << std::endl;
+  }
+
+  if (shardConfig.preemption != PreemptionMode::NONE) {
+    std::cout << "\n : " << preemptions << std::endl;
+  }
+  if (shardConfig.scaling.enabled) {
+    std::cout << "\n :  " << scaleUps << ",  " << scaleDowns
+      << ",      " << std::setprecision(2) << onlineDevices << std::endl;
+  }
+
+  const SelectionPolicy& policy = shardConfig.selection;
+  if (policy.discipline != SelectionDiscipline::LIFO_PRIORITY) {
+    static const char* disciplineNames[] = { "D24", "EDF", " " };
+    std::cout << "\n 3:    (  : " << disciplineNames[static_cast<int>(policy.discipline)] << ")." << std::endl;
+    std::cout << std::setw(10) << "   " << std::setw(15) << "" << std::setw(15) << "P" << std::endl;
+    for (const auto& entry : total) {
+      const MergedSource& s = entry.second;
+      Priority p = shardConfig.sources[entry.first - 1].priority;
+      double p_miss = (s.completed > 0) ? static_cast<double>(s.deadlineMisses) / s.completed : 0.0;
+      std::cout << std::setw(10) << "" << entry.first << std::setw(15) << std::fixed << std::setprecision(4) << policy.deadlineFor(p)
+        << std::setw(15) << p_miss << std::endl;
+    }
+  }
+
+  std::cout << "\n-----------------------------------------------------------------\n" << std::endl;
+}
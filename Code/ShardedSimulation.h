@@ -0,0 +1,78 @@
+#ifndef SHARDEDSIMULATION_H
+#define SHARDEDSIMULATION_H
+
+#include "SimulationController.h"
+#include <vector>
+#include <memory>
+#include <queue>
+#include <random>
+#include <utility>
+#include <functional>
+
+//      
+enum class RoutingPolicy {
+  RANDOM,               //  
+  ROUND_ROBIN,          //  
+  JOIN_SHORTEST_QUEUE,  //      (    )
+  POWER_OF_D            //   d   
+};
+
+//   
+struct ShardedConfig {
+  int shardCount;           //  
+  SimulationConfig shard;   //   : , , , , ,  ,
+                            //    seed (0 -   ).     :
+                            //      shardCount   
+  RoutingPolicy policy;     //  
+  int choices;              // d  POWER_OF_D
+
+  ShardedConfig();
+};
+
+//     K     .   -
+//  SimulationController    ;    
+// .      ,         
+class ShardedSimulation {
+private:
+  typedef std::pair<SimTime, int> ShardEntry; //       
+
+  ShardedConfig config;
+  std::vector<std::unique_ptr<SimulationController>> shards;
+  std::vector<Source> sources;   //   : shardCount   
+  EventCalendar arrivals;        //    (ID   -   + 1)
+  //     .  ,    ,
+  //    ,     O(log K)
+  std::priority_queue<ShardEntry, std::vector<ShardEntry>, std::greater<ShardEntry>> shardEvents;
+  std::default_random_engine routerGenerator;
+  int roundRobinPointer;
+  SimTime currentTime;
+  SimTime simulationEndTime;
+  int nextRequestId;
+
+  int routeArrival();
+  void scheduleGeneration(int streamIndex);
+  //       
+  void trackShard(int shardIndex);
+  //     , -1 -  
+  int nextShard();
+
+public:
+  ShardedSimulation(const ShardedConfig& cfg);
+
+  //      :       
+  bool stepSimulation();
+
+  //      
+  void runToCompletion();
+
+  int getShardCount() const { return static_cast<int>(shards.size()); }
+  //      (  0)
+  SimulationResults getShardResults(int shardIndex) const { return shards.at(shardIndex)->getResults(); }
+
+  //         
+  void printSummary();
+
+  static const char* policyToString(RoutingPolicy policy);
+};
+
+#endif
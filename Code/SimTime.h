@@ -0,0 +1,50 @@
+#ifndef SIMTIME_H
+#define SIMTIME_H
+
+#include <cmath>
+#include <limits>
+
+//   .
+//
+//    - double.    SERVICE_CENTER_TICK_TIME   
+//   (  1  = 1e-9   ):   
+//  ,    ,    (
+// , )       .
+//   -   double      .
+#ifdef SERVICE_CENTER_TICK_TIME
+
+#ifndef SERVICE_CENTER_TICKS_PER_UNIT
+#define SERVICE_CENTER_TICKS_PER_UNIT 1000000000LL
+#endif
+
+typedef long long SimTime;
+
+const double SIM_TICKS_PER_UNIT = static_cast<double>(SERVICE_CENTER_TICKS_PER_UNIT);
+
+inline SimTime simTimeInfinity() { return std::numeric_limits<SimTime>::max(); }
+
+inline SimTime toSimTime(double t) {
+  //      (   ) 
+  double ticks = t * SIM_TICKS_PER_UNIT;
+  if (!(ticks < 9.2e18)) {
+    return simTimeInfinity();
+  }
+  if (ticks <= -9.2e18) {
+    return std::numeric_limits<SimTime>::lowest();
+  }
+  return static_cast<SimTime>(std::llround(ticks));
+}
+
+inline double fromSimTime(SimTime t) { return static_cast<double>(t) / SIM_TICKS_PER_UNIT; }
+
+#else
+
+typedef double SimTime;
+
+inline SimTime simTimeInfinity() { return std::numeric_limits<double>::infinity(); }
+inline SimTime toSimTime(double t) { return t; }
+inline double fromSimTime(SimTime t) { return t; }
+
+#endif
+
+#endif
@@ -1,32 +1,99 @@
 #include "SimulationController.h"
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+
+namespace {
+
+//        
+int eventRank(EventType type) {
+  switch (type) {
+  case EventType::SERVICE_COMPLETE: return 0; //   
+  case EventType::DEVICE_ONLINE: return 1;
+  case EventType::GENERATION: return 2;
+  default: return 3; //       
+  }
+}
 
-extern volatile sig_atomic_t g_signalRaised;
+}
 
-SimulationController::SimulationController()
-  : buffer(5), //   5
-  dispatcher(&buffer, {}), //  
-  currentTime(0.0),
-  simulationEndTime(1000.0), //  
-  bufferSize(5),
-  meanServiceTime(10.0), //   
-  nextRequestId(1) { //  
+double SimulationResults::rejectionProbability(Priority p) const {
+  int generated = 0;
+  int rejected = 0;
+  for (const SourceResults& s : sources) {
+    if (s.priority == p) {
+      generated += s.generated;
+      rejected += s.rejected;
+    }
+  }
+  return (generated > 0) ? static_cast<double>(rejected) / generated : 0.0;
+}
 
+SimulationController::SimulationController(const SimulationConfig& config)
+  : buffer(config.bufferSize),
+  dispatcher(&buffer, {}), //  
+  currentTime(0),
+  simulationEndTime(toSimTime(config.simulationEndTime)), //  
+  bufferSize(config.bufferSize),
+  meanServiceTime(config.meanServiceTime), //   
+  deviceCount(config.deviceCount),
+  seed(config.seed),
+  preemption(config.preemption),
+  totalPreemptions(0),
+  externalArrivals(config.externalArrivals),
+  sourceConfigs(config.sources),
+  serviceDistribution(config.serviceDistribution),
+  output(&std::cout),
+  eventsProcessed(0),
+  scaling(config.scaling),
+  lastScalingAction(-simTimeInfinity()),
+  occupancyArea(0.0),
+  occupancyMark(0),
+  windowStart(0),
+  windowGenerated(0),
+  windowRejected(0),
+  scaleUps(0),
+  scaleDowns(0),
+  nextRequestId(1), //  
+  traceBatchOpen(false) {
+
+  buffer.setSelectionPolicy(config.selection);
   initializeSystem();
 }
 
 void SimulationController::initializeSystem() {
-  //  1:  ( )
-  sources.emplace_back(1, 10.0, Priority::WARRANTY); //     10
-  //  2:  ( )
-  sources.emplace_back(2, 7.0, Priority::CORPORATE);
-  //  3:  ( )
-  sources.emplace_back(3, 5.0, Priority::PRIVATE);
+  //     (  : , , )
+  for (size_t i = 0; i < sourceConfigs.size(); ++i) {
+    const SourceConfig& sc = sourceConfigs[i];
+    sources.emplace_back(static_cast<int>(i) + 1, sc.interval, sc.priority);
+    if (sc.intervalDistribution) {
+      sources.back().setIntervalDistribution(sc.intervalDistribution);
+    }
+    if (sc.arrivalProfile) {
+      sources.back().setArrivalProfile(sc.arrivalProfile);
+    }
+  }
 
-  //  
-  for (int i = 1; i <= 3; ++i) {
-    devices.emplace_back(i, meanServiceTime);
+  //  (  )
+  for (int i = 1; i <= deviceCount; ++i) {
+    if (serviceDistribution) {
+      devices.emplace_back(i, serviceDistribution);
+    }
+    else {
+      devices.emplace_back(i, meanServiceTime);
+    }
+  }
+
+  //  :      seed
+  if (seed != 0) {
+    for (auto& source : sources) {
+      source.reseed(seed + source.getSourceId());
+    }
+    for (auto& device : devices) {
+      device.reseed(seed + 1000 + device.getDeviceId());
+    }
   }
 
   //     
@@ -35,66 +102,250 @@ void SimulationController::initializeSystem() {
     devicePtrs.push_back(&device);
   }
   dispatcher = Dispatcher(&buffer, devicePtrs);
+  completionHandles.assign(devices.size(), EventHandle());
+  startupHandles.assign(devices.size(), EventHandle());
+
+  if (scaling.enabled) {
+    scaling.validate();
+    if (deviceCount < scaling.minDevices || deviceCount > scaling.maxDevices) {
+      throw std::invalid_argument("      .");
+    }
+    eventQueue.push(Event(toSimTime(scaling.evaluationInterval), EventType::SCALING_CHECK, -1, -1));
+  }
 
   //      
   for (auto& source : sources) {
-    double nextGenTime = source.getNextGenerationTime(currentTime);
-    Request firstRequest = source.generateRequest(nextGenTime, nextRequestId++);
-    firstRequest.setTimeEnteredBuffer(nextGenTime);
-    Event genEvent(nextGenTime, "GENERATION", source.getSourceId(), firstRequest.getRequestId(), firstRequest);
-    eventQueue.push(genEvent);
+    firstArrivalHandles.push_back(externalArrivals ? EventHandle() : scheduleNextGeneration(source));
   }
 
   //  
   totalRequestsGenerated = 0;
   totalRequestsRejected = 0;
   totalRequestsCompleted = 0;
-  for (int i = 1; i <= 3; ++i) {
+  for (const auto& source : sources) {
+    int i = source.getSourceId();
     requestsBySource[i] = 0;
     rejectedBySource[i] = 0;
     completedBySource[i] = 0;
-    totalTimeInSystem[i] = 0.0;
-    totalTimeWaiting[i] = 0.0;
-    totalTimeProcessing[i] = 0.0;
+    totalTimeInSystem[i] = 0;
+    totalTimeWaiting[i] = 0;
+    totalTimeProcessing[i] = 0;
     sumSqDiffWaitingTime[i] = 0.0;
     sumSqDiffProcessingTime[i] = 0.0;
   }
 }
 
+void SimulationController::setDeviceServiceDistribution(int deviceId, std::shared_ptr<const Distribution> distribution) {
+  int maxId = std::max(static_cast<int>(devices.size()), scaling.enabled ? scaling.maxDevices : 0);
+  if (deviceId < 1 || deviceId > maxId || !distribution) {
+    throw std::out_of_range(" :  ID    .");
+  }
+  deviceServiceOverrides[deviceId].all = distribution;
+  if (deviceId <= static_cast<int>(devices.size())) {
+    devices[deviceId - 1].setServiceDistribution(distribution);
+  }
+}
+
+void SimulationController::setDeviceServiceDistribution(int deviceId, Priority p, std::shared_ptr<const Distribution> distribution) {
+  int maxId = std::max(static_cast<int>(devices.size()), scaling.enabled ? scaling.maxDevices : 0);
+  if (deviceId < 1 || deviceId > maxId) {
+    throw std::out_of_range(" :  ID .");
+  }
+  deviceServiceOverrides[deviceId].byPriority[static_cast<int>(p)] = distribution;
+  if (deviceId <= static_cast<int>(devices.size())) {
+    devices[deviceId - 1].setServiceDistribution(p, distribution);
+  }
+}
+
+void SimulationController::applyServiceOverrides(Device& device) {
+  auto it = deviceServiceOverrides.find(device.getDeviceId());
+  if (it == deviceServiceOverrides.end()) {
+    return;
+  }
+  if (it->second.all) {
+    device.setServiceDistribution(it->second.all);
+  }
+  for (int p = 0; p < 3; ++p) {
+    if (it->second.byPriority[p]) {
+      device.setServiceDistribution(static_cast<Priority>(p), it->second.byPriority[p]);
+    }
+  }
+}
+
+void SimulationController::setSourceIntervalDistribution(int sourceId, std::shared_ptr<const Distribution> distribution) {
+  sources.at(sourceId - 1).setIntervalDistribution(distribution);
+}
+
+void SimulationController::setSourceArrivalProfile(int sourceId, std::shared_ptr<const ArrivalProfile> profile) {
+  if (eventsProcessed > 0 || traceSource || externalArrivals) {
+    throw std::logic_error("     .");
+  }
+  Source& source = sources.at(sourceId - 1);
+  source.setArrivalProfile(profile);
+  //        -   
+  eventQueue.cancel(firstArrivalHandles[sourceId - 1]);
+  firstArrivalHandles[sourceId - 1] = scheduleNextGeneration(source);
+}
+
+EventHandle SimulationController::scheduleNextGeneration(Source& source) {
+  SimTime nextGenTime = source.getNextGenerationTime(currentTime);
+  if (nextGenTime == simTimeInfinity()) {
+    return EventHandle(); //     
+  }
+  Request nextRequest = source.generateRequest(nextGenTime, nextRequestId++);
+  nextRequest.setTimeEnteredBuffer(nextGenTime);
+  return eventQueue.push(Event(nextGenTime, EventType::GENERATION, source.getSourceId(), nextRequest.getRequestId(), nextRequest));
+}
+
+void SimulationController::submitArrival(const Request& req) {
+  if (!externalArrivals) {
+    throw std::logic_error("      .");
+  }
+  if (req.getCreationTime() < currentTime) {
+    throw std::invalid_argument("    .");
+  }
+  eventQueue.push(Event(req.getCreationTime(), EventType::GENERATION, req.getSourceId(), req.getRequestId(), req));
+}
+
+void SimulationController::loadTrace(const std::vector<std::string>& paths) {
+  if (eventsProcessed > 0 || externalArrivals) {
+    throw std::logic_error("          .");
+  }
+  traceSource.reset(new TraceSource(paths));
+
+  //      
+  eventQueue = EventCalendar();
+  if (scaling.enabled) {
+    eventQueue.push(Event(toSimTime(scaling.evaluationInterval), EventType::SCALING_CHECK, -1, -1));
+  }
+  scheduleNextTraceArrival();
+}
+
+bool SimulationController::scheduleNextTraceArrival() {
+  TraceRecord record;
+  if (!traceSource->next(record)) {
+    return false;
+  }
+  eventQueue.push(makeTraceArrival(record));
+  return true;
+}
+
+Event SimulationController::makeTraceArrival(const TraceRecord& record) {
+  SimTime arrivalTime = toSimTime(record.time);
+  Request request(nextRequestId++, record.sourceId, arrivalTime, record.priority);
+  request.setTimeEnteredBuffer(arrivalTime);
+  if (record.serviceTime >= 0.0) {
+    request.setPresetServiceTime(toSimTime(record.serviceTime));
+  }
+  return Event(arrivalTime, EventType::GENERATION, record.sourceId, request.getRequestId(), request);
+}
+
 //   (1)
 void SimulationController::runSimulationStepByStep() {
-  std::cout << "===      ===" << std::endl;
-  std::cout << "  :" << std::endl;
+  *output << "===      ===" << std::endl;
+  *output << "  :" << std::endl;
   printCurrentState();
-  std::cout << "\n Enter    ... (Ctrl+C  )" << std::endl;
+  *output << "\n Enter    ... (Ctrl+C  )" << std::endl;
   std::cin.get();
-  if (g_signalRaised == SIGINT) return;
+  if (cancellation.isCancelled()) return;
 
   while (stepSimulation()) {
     printCurrentState(); //     
-    std::cout << "\n---  Enter    ( Ctrl+C  ) ---" << std::endl;
+    *output << "\n---  Enter    ( Ctrl+C  ) ---" << std::endl;
     std::cin.get();
-    if (g_signalRaised == SIGINT) {
+    if (cancellation.isCancelled()) {
       printSummary();
       return;
     }
   }
 
-  std::cout << "\n ." << std::endl;
+  *output << "\n ." << std::endl;
 }
 
 //   (1)
 void SimulationController::runSimulationAutomatic() {
 
-  while (stepSimulation()) {
+  //          
+  while (stepSimulationBatch()) {
     //    ,  
   }
 
   printSummary();
 }
 
+void SimulationController::runToCompletion() {
+  while (stepSimulationBatch()) {
+  }
+}
+
+long long SimulationController::runForEvents(long long eventCount) {
+  long long before = eventsProcessed;
+  //   ,         
+  while (eventsProcessed - before < eventCount && stepSimulationBatch()) {
+  }
+  return eventsProcessed - before;
+}
+
+void SimulationController::runUntil(double untilTime) {
+  SimTime until = toSimTime(untilTime);
+  while (!eventQueue.empty() && eventQueue.top().time <= until && stepSimulationBatch()) {
+  }
+  if (!cancellation.isCancelled()) {
+    advanceTime(std::max(currentTime, std::min(until, simulationEndTime)));
+  }
+}
+
+bool SimulationController::isFinished() const {
+  return cancellation.isCancelled() || eventQueue.empty() || eventQueue.top().time > simulationEndTime;
+}
+
+SimulationResults SimulationController::getResults() const {
+  SimulationResults results;
+
+  for (const auto& sourceEntry : requestsBySource) {
+    int i = sourceEntry.first;
+    SourceResults s;
+    s.sourceId = i;
+    auto pri = priorityBySource.find(i);
+    s.priority = (pri != priorityBySource.end()) ? pri->second : Priority::PRIVATE;
+    s.generated = sourceEntry.second;
+    s.rejected = rejectedBySource.count(i) ? rejectedBySource.at(i) : 0;
+    s.completed = completedBySource.count(i) ? completedBySource.at(i) : 0;
+    s.rejectionProbability = (s.generated > 0) ? static_cast<double>(s.rejected) / s.generated : 0.0;
+    s.meanTimeInSystem = (s.completed > 0) ? fromSimTime(totalTimeInSystem.at(i)) / s.completed : 0.0;
+    s.meanWaiting = (s.completed > 0) ? fromSimTime(totalTimeWaiting.at(i)) / s.completed : 0.0;
+    s.meanProcessing = (s.completed > 0) ? fromSimTime(totalTimeProcessing.at(i)) / s.completed : 0.0;
+    s.waitingVariance = (s.completed > 1) ? sumSqDiffWaitingTime.at(i) / (s.completed - 1) : 0.0;
+    s.processingVariance = (s.completed > 1) ? sumSqDiffProcessingTime.at(i) / (s.completed - 1) : 0.0;
+    auto waits = waitingP99.find(i);
+    s.p99Waiting = (waits != waitingP99.end()) ? waits->second.getValue() : 0.0;
+    auto misses = deadlineMissesBySource.find(i);
+    s.deadlineMissRate = (s.completed > 0 && misses != deadlineMissesBySource.end()) ? static_cast<double>(misses->second) / s.completed : 0.0;
+    results.sources.push_back(s);
+  }
+  results.p99Waiting = allWaitingP99.getValue();
+
+  //  runUntil         
+  SimTime observedEnd = std::min(currentTime, simulationEndTime);
+  double deviceTimeOnline = 0.0;
+  for (const Device& dev : devices) {
+    double timeOnline = fromSimTime(dev.getTotalTimeOnline(observedEnd));
+    deviceTimeOnline += timeOnline;
+    results.deviceUtilization.push_back((timeOnline > 0.0) ? fromSimTime(dev.getTotalTimeBusy()) / timeOnline : 0.0);
+  }
+  results.meanOnlineDevices = (observedEnd > 0) ? deviceTimeOnline / fromSimTime(observedEnd) : 0.0;
+  results.scaleUps = scaleUps;
+  results.scaleDowns = scaleDowns;
+  results.preemptions = totalPreemptions;
+  return results;
+}
+
 bool SimulationController::stepSimulation() {
+  if (cancellation.isCancelled()) {
+    return false;
+  }
   if (eventQueue.empty()) {
+    finishAtEndTime();
     return false;
   }
 
@@ -102,90 +353,210 @@ bool SimulationController::stepSimulation() {
   eventQueue.pop();
 
   if (currentEvent.time > simulationEndTime) {
+    finishAtEndTime();
     return false;
   }
 
-  currentTime = currentEvent.time;
+  advanceTime(currentEvent.time);
+  eventsProcessed++;
 
   //  
-  if (currentEvent.type == "GENERATION") {
-    handleGenerationEvent(currentEvent);
+  handleEvent(currentEvent);
+
+  //      
+  dispatchPending();
+
+  return true;
+}
+
+bool SimulationController::stepSimulationBatch() {
+  if (isFinished()) {
+    if (!cancellation.isCancelled()) {
+      finishAtEndTime();
+    }
+    return false;
+  }
+
+  //         
+  advanceTime(eventQueue.top().time);
+  currentBatch.clear();
+  while (!eventQueue.empty() && eventQueue.top().time == currentTime) {
+    currentBatch.push_back(eventQueue.top());
+    eventQueue.pop();
   }
-  else if (currentEvent.type == "SERVICE_COMPLETE") {
-    handleServiceCompleteEvent(currentEvent);
+
+  //        :     ,
+  //            
+  double traceTime = 0.0;
+  traceBatchOpen = traceSource && std::any_of(currentBatch.begin(), currentBatch.end(),
+    [](const Event& e) { return e.type == EventType::GENERATION; });
+  while (traceBatchOpen && traceSource->peekTime(traceTime) && toSimTime(traceTime) == currentTime) {
+    TraceRecord record;
+    traceSource->next(record);
+    currentBatch.push_back(makeTraceArrival(record));
+  }
+
+  //    :   ,
+  //         
+  std::sort(currentBatch.begin(), currentBatch.end(), [](const Event& a, const Event& b) {
+    int aRank = eventRank(a.type);
+    int bRank = eventRank(b.type);
+    if (aRank != bRank) {
+      return aRank < bRank;
+    }
+    if (a.deviceId != b.deviceId) {
+      return a.deviceId < b.deviceId;
+    }
+    if (a.sourceId != b.sourceId) {
+      return a.sourceId < b.sourceId;
+    }
+    return a.requestId < b.requestId;
+  });
+
+  eventsProcessed += static_cast<long long>(currentBatch.size());
+  bool devicesReleased = false;
+  bool arrivalsStarted = false;
+  for (const Event& event : currentBatch) {
+    int rank = eventRank(event.type);
+    //         ,   
+    //    :        
+    //   
+    if (!arrivalsStarted && rank >= eventRank(EventType::GENERATION)) {
+      arrivalsStarted = true;
+      if (devicesReleased) {
+        dispatchPending();
+      }
+    }
+    handleEvent(event);
+    devicesReleased = devicesReleased || rank < eventRank(EventType::GENERATION);
+
+    //    ,     ,    
+    //    .      .
+    //    (D1004)   ,      
+    if (event.type == EventType::GENERATION && (preemption != PreemptionMode::NONE || dispatcher.hasFreeDevice())) {
+      dispatchPending();
+    }
   }
 
-  dispatcher.assignToDevice(currentTime);
+  //      (,    )
+  dispatchPending();
+
+  if (traceBatchOpen) {
+    traceBatchOpen = false;
+    scheduleNextTraceArrival();
+  }
 
   return true;
 }
 
+void SimulationController::finishAtEndTime() {
+  //      -      
+  if (currentTime < simulationEndTime) {
+    advanceTime(simulationEndTime);
+  }
+}
+
+void SimulationController::advanceTime(SimTime time) {
+  occupancyArea += buffer.getCurrentSize() * fromSimTime(time - occupancyMark);
+  occupancyMark = time;
+  currentTime = time;
+}
+
+void SimulationController::handleEvent(const Event& event) {
+  switch (event.type) {
+  case EventType::GENERATION:
+    handleGenerationEvent(event);
+    break;
+  case EventType::SERVICE_COMPLETE:
+    handleServiceCompleteEvent(event);
+    break;
+  case EventType::DEVICE_ONLINE:
+    handleDeviceOnline(event);
+    break;
+  case EventType::SCALING_CHECK:
+    handleScalingCheck();
+    break;
+  }
+}
+
 void SimulationController::printCurrentState() {
-  std::cout << "\n===    ===" << std::endl;
-  std::cout << "  : " << currentTime << std::endl;
+  *output << "\n===    ===" << std::endl;
+  *output << "  : " << fromSimTime(currentTime) << std::endl;
 
-  std::cout << " (): " << totalRequestsCompleted << std::endl;
-  std::cout << " (): " << totalRequestsRejected << std::endl;
+  *output << " (): " << totalRequestsCompleted << std::endl;
+  *output << " (): " << totalRequestsRejected << std::endl;
 
-  std::cout << "\n---   (P ) ---" << std::endl;
-  for (int i = 1; i <= 3; ++i) {
+  *output << "\n---   (P ) ---" << std::endl;
+  //        -   
+  for (const auto& sourceEntry : requestsBySource) {
+    int i = sourceEntry.first;
     double p_otk = (requestsBySource[i] > 0) ? static_cast<double>(rejectedBySource[i]) / requestsBySource[i] : 0.0;
-    std::cout << "   " << i << ": " << std::fixed << std::setprecision(4) << p_otk << std::endl;
+    *output << "   " << i << ": " << std::fixed << std::setprecision(4) << p_otk << std::endl;
   }
 
-  std::cout << "\n---  ---" << std::endl;
-  std::cout << "  ringPointer (): " << buffer.getRingPointer() << std::endl;
-  std::cout << "  ringPointerDevice (): " << dispatcher.getRingPointerDevice() << std::endl;
+  *output << "\n---  ---" << std::endl;
+  *output << "  ringPointer (): " << buffer.getRingPointer() << std::endl;
+  *output << "  ringPointerDevice (): " << dispatcher.getRingPointerDevice() << std::endl;
 
-  std::cout << "\n---  ---" << std::endl;
-  std::cout << ": " << buffer.getCapacity() << ", : " << buffer.getCurrentSize() << std::endl;
+  *output << "\n---  ---" << std::endl;
+  *output << ": " << buffer.getCapacity() << ", : " << buffer.getCurrentSize() << std::endl;
   const auto& slots = buffer.getSlots();
   const auto& occupied = buffer.getOccupancy();
   for (size_t i = 0; i < slots.size(); ++i) {
     if (occupied[i]) {
-      std::cout << "   " << i << ":  " << slots[i].getIdString()
+      *output << "   " << i << ":  " << slots[i].getIdString()
         << " ( " << slots[i].getSourceId() << ", : " << Request::priorityToString(slots[i].getPriority()) << ")" << std::endl;
     }
     else {
-      std::cout << "   " << i << ": " << std::endl;
+      *output << "   " << i << ": " << std::endl;
     }
   }
 
-  std::cout << "\n---  ---" << std::endl;
+  *output << "\n---  ---" << std::endl;
   for (size_t i = 0; i < devices.size(); ++i) {
     const Device& dev = devices[i];
-    std::cout << "   " << dev.getDeviceId() << ": ";
+    *output << "   " << dev.getDeviceId() << ": ";
     if (dev.getIsBusy()) {
-      std::cout << " ( " << dev.getCurrentRequest().getIdString()
-        << ",  " << dev.getCurrentRequest().getSourceId() << ",  : " << dev.getServiceStartTime() << ")" << std::endl;
+      *output << " ( " << dev.getCurrentRequest().getIdString()
+        << ",  " << dev.getCurrentRequest().getSourceId() << ",  : " << fromSimTime(dev.getServiceStartTime()) << ")"
+        << (dev.isRetiring() ? ", " : "") << std::endl;
+    }
+    else if (!dev.isOnline()) {
+      *output << (eventQueue.contains(startupHandles[i]) ? "" : "  ") << std::endl;
     }
     else {
-      std::cout << "" << std::endl;
+      *output << "" << std::endl;
     }
   }
 
-  std::cout << "\n---   () ---" << std::endl;
+  *output << "\n---   () ---" << std::endl;
   auto tempQueue = eventQueue;
   if (tempQueue.empty()) {
-    std::cout << "  ()" << std::endl;
+    *output << "  ()" << std::endl;
   }
   else {
     // 
-    std::cout << std::setw(10) << "" << " | " << std::setw(15) << "" << " | " << std::setw(10) << "" << " | " << std::setw(10) << "" << " | " << std::setw(10) << "" << std::endl;
-    std::cout << std::string(70, '-') << std::endl;
+    *output << std::setw(10) << "" << " | " << std::setw(15) << "" << " | " << std::setw(10) << "" << " | " << std::setw(10) << "" << " | " << std::setw(10) << "" << std::endl;
+    *output << std::string(70, '-') << std::endl;
     while (!tempQueue.empty()) {
       const Event& e = tempQueue.top();
-      std::cout << std::setw(10) << e.time << " | " << std::setw(15) << e.type;
-      if (e.type == "GENERATION") {
-        std::cout << " | " << std::setw(10) << e.sourceId << " | " << std::setw(10) << "-" << " | " << std::setw(10) << e.requestId << std::endl;
+      *output << std::setw(10) << fromSimTime(e.time) << " | " << std::setw(15) << eventTypeToString(e.type);
+      if (e.type == EventType::GENERATION) {
+        *output << " | " << std::setw(10) << e.sourceId << " | " << std::setw(10) << "-" << " | " << std::setw(10) << e.requestId << std::endl;
+      }
+      else if (e.type == EventType::SERVICE_COMPLETE) {
+        *output << " | " << std::setw(10) << "-" << " | " << std::setw(10) << e.deviceId << " | " << std::setw(10) << e.requestId << std::endl;
+      }
+      else if (e.type == EventType::DEVICE_ONLINE) {
+        *output << " | " << std::setw(10) << "-" << " | " << std::setw(10) << e.deviceId << " | " << std::setw(10) << "-" << std::endl;
       }
-      else if (e.type == "SERVICE_COMPLETE") {
-        std::cout << " | " << std::setw(10) << "-" << " | " << std::setw(10) << e.deviceId << " | " << std::setw(10) << e.requestId << std::endl;
+      else {
+        *output << " | " << std::setw(10) << "-" << " | " << std::setw(10) << "-" << " | " << std::setw(10) << "-" << std::endl;
       }
       tempQueue.pop();
     }
   }
-  std::cout << "=================================" << std::endl;
+  *output << "=================================" << std::endl;
 }
 
 void SimulationController::handleGenerationEvent(const Event& event) {
@@ -193,41 +564,34 @@ void SimulationController::handleGenerationEvent(const Event& event) {
   int sourceId = event.sourceId;
 
   totalRequestsGenerated++;
+  windowGenerated++;
   requestsBySource[sourceId]++;
+  priorityBySource[sourceId] = req.getPriority();
 
   //     
   req.setTimeEnteredBuffer(currentTime);
 
   Request replacedReq; //     
-  bool accepted = dispatcher.acceptRequest(req, replacedReq);
+  //     (  -   D1004),     
+  if (!dispatcher.acceptRequest(req, replacedReq)) {
+    throw std::logic_error("    " + req.getIdString() + ".");
+  }
+  //        (dispatchPending)
 
-  if (accepted) {
-    // ,     .
-    AssignmentResult assignment = dispatcher.assignToDevice(currentTime);
-    if (assignment.success) {
-      //        
-      Device& assignedDevice = devices[assignment.assignedDeviceId - 1];
-      double serviceDuration = assignedDevice.getServiceTime();
-      double serviceCompletionTime = assignment.serviceStartTime + serviceDuration;
-      Event serviceCompleteEvent(serviceCompletionTime, "SERVICE_COMPLETE", assignment.assignedDeviceId, assignment.assignedRequestId);
-      eventQueue.push(serviceCompleteEvent);
-    }
+  // ,     (D1004)
+  if (replacedReq.getStatus() == RequestStatus::REJECTED) {
+    //     
+    recordRejection(replacedReq);
+  }
 
-    // ,     (D1004)
-    if (replacedReq.getStatus() == RequestStatus::REJECTED) {
-      //     
-      totalRequestsRejected++;
-      rejectedBySource[replacedReq.getSourceId()]++;
+  if (traceSource) {
+    //           
+    if (!traceBatchOpen) {
+      scheduleNextTraceArrival();
     }
-
-    double nextGenTime = sources[sourceId - 1].getNextGenerationTime(currentTime);
-    Request nextRequest = sources[sourceId - 1].generateRequest(nextGenTime, nextRequestId++);
-    nextRequest.setTimeEnteredBuffer(nextGenTime);
-    Event nextGenEvent(nextGenTime, "GENERATION", sourceId, nextRequest.getRequestId(), nextRequest);
-    eventQueue.push(nextGenEvent);
   }
-  else {
-    std::cout << ": acceptRequest  false." << std::endl;
+  else if (!externalArrivals) {
+    scheduleNextGeneration(sources[sourceId - 1]);
   }
 }
 
@@ -238,19 +602,23 @@ void SimulationController::handleServiceCompleteEvent(const Event& event) {
   Device& device = devices[deviceId - 1];
 
   if (device.getIsBusy() == false || device.getCurrentRequest().getRequestId() != requestId) {
-    std::cout << ":  " << deviceId << "    " << requestId << "    ." << std::endl;
+    *output << ":  " << deviceId << "    " << requestId << "    ." << std::endl;
     return;
   }
 
   Request completedReq = device.getCurrentRequest();
-  double serviceStartTime = device.getServiceStartTime();
-  double serviceCompletionTime = currentTime;
-  double serviceDuration = serviceCompletionTime - serviceStartTime;
-  double totalTimeInSystemValue = currentTime - completedReq.getCreationTime();
-  double waitTime = totalTimeInSystemValue - serviceDuration;
+  SimTime serviceStartTime = device.getServiceStartTime();
+  SimTime serviceCompletionTime = currentTime;
+  //      
+  SimTime serviceDuration = serviceCompletionTime - serviceStartTime + completedReq.getAccumulatedServiceTime();
+  SimTime totalTimeInSystemValue = currentTime - completedReq.getCreationTime();
+  SimTime waitTime = totalTimeInSystemValue - serviceDuration;
   int sourceId = completedReq.getSourceId();
 
   device.completeService(currentTime); //   
+  if (device.isRetiring()) {
+    device.takeOffline(currentTime); //       
+  }
 
   totalRequestsCompleted++;
   completedBySource[sourceId]++;
@@ -259,12 +627,17 @@ void SimulationController::handleServiceCompleteEvent(const Event& event) {
   totalTimeInSystem[sourceId] += totalTimeInSystemValue;
   totalTimeWaiting[sourceId] += waitTime;
   totalTimeProcessing[sourceId] += serviceDuration;
+  waitingP99[sourceId].add(fromSimTime(waitTime));
+  allWaitingP99.add(fromSimTime(waitTime));
+  if (fromSimTime(waitTime) > buffer.getSelectionPolicy().deadlineFor(completedReq.getPriority())) {
+    deadlineMissesBySource[sourceId]++;
+  }
 
   //      
   //    (T )
   int n_prev_wait = completedBySource[sourceId] - 1; //    
-  double old_mean_wait = (n_prev_wait > 0) ? totalTimeWaiting[sourceId - 1] / n_prev_wait : 0.0; //   T 
-  double new_value_wait = waitTime; //   T    
+  double old_mean_wait = (n_prev_wait > 0) ? fromSimTime(totalTimeWaiting[sourceId - 1]) / n_prev_wait : 0.0; //   T 
+  double new_value_wait = fromSimTime(waitTime); //   T    
   if (n_prev_wait == 0) {
     //        i,   = 0
     sumSqDiffWaitingTime[sourceId] = 0.0;
@@ -273,14 +646,14 @@ void SimulationController::handleServiceCompleteEvent(const Event& event) {
     //    
     double old_sum_sq_diff = sumSqDiffWaitingTime[sourceId];
     //       
-    double new_mean_wait = totalTimeWaiting[sourceId] / completedBySource[sourceId];
+    double new_mean_wait = fromSimTime(totalTimeWaiting[sourceId]) / completedBySource[sourceId];
     sumSqDiffWaitingTime[sourceId] = old_sum_sq_diff + (new_value_wait - old_mean_wait) * (new_value_wait - new_mean_wait);
   }
 
   //    (T )
   //   T 
-  double old_mean_proc = (n_prev_wait > 0) ? totalTimeProcessing[sourceId - 1] / n_prev_wait : 0.0;
-  double new_value_proc = serviceDuration; //   T    
+  double old_mean_proc = (n_prev_wait > 0) ? fromSimTime(totalTimeProcessing[sourceId - 1]) / n_prev_wait : 0.0;
+  double new_value_proc = fromSimTime(serviceDuration); //   T    
   if (n_prev_wait == 0) {
     //        i,   = 0
     sumSqDiffProcessingTime[sourceId] = 0.0;
@@ -289,49 +662,275 @@ void SimulationController::handleServiceCompleteEvent(const Event& event) {
     //    
     double old_sum_sq_diff = sumSqDiffProcessingTime[sourceId];
     //       
-    double new_mean_proc = totalTimeProcessing[sourceId] / completedBySource[sourceId];
+    double new_mean_proc = fromSimTime(totalTimeProcessing[sourceId]) / completedBySource[sourceId];
     sumSqDiffProcessingTime[sourceId] = old_sum_sq_diff + (new_value_proc - old_mean_proc) * (new_value_proc - new_mean_proc);
   }
+}
+
+void SimulationController::dispatchPending() {
+  pendingAssignments.clear();
+  dispatcher.assignAll(currentTime, pendingAssignments);
+
+  //      
+  for (const AssignmentResult& assignment : pendingAssignments) {
+    scheduleServiceCompletion(assignment);
+  }
+
+  if (preemption != PreemptionMode::NONE) {
+    preemptLowerPriorityService();
+  }
+}
+
+void SimulationController::scheduleServiceCompletion(const AssignmentResult& assignment) {
+  Device& assignedDevice = devices[assignment.assignedDeviceId - 1];
+  SimTime serviceDuration = assignedDevice.getServiceTime();
+  SimTime serviceCompletionTime = assignment.serviceStartTime + serviceDuration;
+  Event serviceCompleteEvent(serviceCompletionTime, EventType::SERVICE_COMPLETE, assignment.assignedDeviceId, assignment.assignedRequestId);
+  completionHandles[assignment.assignedDeviceId - 1] = eventQueue.push(serviceCompleteEvent);
+}
+
+void SimulationController::preemptLowerPriorityService() {
+  //      ,     
+  while (!buffer.isEmpty()) {
+    Priority waitingPriority = dispatcher.selectRequestForService().getPriority();
+
+    //     ,   -   (  )
+    Device* victim = nullptr;
+    for (Device& dev : devices) {
+      //             
+      if (!dev.getIsBusy() || dev.isRetiring() || dev.getCurrentRequest().getPriority() >= waitingPriority) {
+        continue;
+      }
+      if (!victim || dev.getCurrentRequest().getPriority() < victim->getCurrentRequest().getPriority() ||
+        (dev.getCurrentRequest().getPriority() == victim->getCurrentRequest().getPriority() &&
+          dev.getServiceStartTime() > victim->getServiceStartTime())) {
+        victim = &dev;
+      }
+    }
+    if (!victim) {
+      return;
+    }
+
+    EventHandle& handle = completionHandles[victim->getDeviceId() - 1];
+    SimTime plannedCompletion = eventQueue.get(handle).time;
+    eventQueue.cancel(handle);
+
+    Request interrupted = victim->getCurrentRequest();
+    SimTime segmentStart = victim->getServiceStartTime();
+    victim->interruptService(currentTime);
+    interrupted.addAccumulatedServiceTime(currentTime - segmentStart);
+    if (preemption == PreemptionMode::RESUME) {
+      interrupted.setPresetServiceTime(plannedCompletion - currentTime);
+    }
+    else {
+      interrupted.setPresetServiceTime(plannedCompletion - segmentStart);
+    }
+    //      :     
+    // (AGING)    ,    (D24)
+    totalPreemptions++;
+
+    //        (D24)
+    AssignmentResult assignment = dispatcher.assignToDevice(currentTime);
+    if (assignment.success) {
+      scheduleServiceCompletion(assignment);
+    }
+
+    //          ,  
+    //  :   D1004  ,   
+    Request replacedReq;
+    if (!dispatcher.requeueRequest(interrupted, replacedReq)) {
+      throw std::logic_error("     " + interrupted.getIdString() + ".");
+    }
+    if (replacedReq.getStatus() == RequestStatus::REJECTED) {
+      recordRejection(replacedReq);
+    }
+  }
+}
 
+void SimulationController::recordRejection(const Request& rejected) {
+  totalRequestsRejected++;
+  windowRejected++;
+  rejectedBySource[rejected.getSourceId()]++;
+}
 
-  AssignmentResult assignment = dispatcher.assignToDevice(currentTime);
-  if (assignment.success) {
-    Device& assignedDevice = devices[assignment.assignedDeviceId - 1];
-    double serviceDuration = assignedDevice.getServiceTime();
-    double serviceCompletionTime = assignment.serviceStartTime + serviceDuration;
-    Event serviceCompleteEvent(serviceCompletionTime, "SERVICE_COMPLETE", assignment.assignedDeviceId, assignment.assignedRequestId);
-    eventQueue.push(serviceCompleteEvent);
+void SimulationController::handleScalingCheck() {
+  ScalingObservation observation;
+  double window = fromSimTime(currentTime - windowStart);
+  observation.time = fromSimTime(currentTime);
+  observation.meanOccupancy = (window > 0.0) ? occupancyArea / window / buffer.getCapacity() : 0.0;
+  observation.rejectionRate = (windowGenerated > 0) ? static_cast<double>(windowRejected) / windowGenerated : 0.0;
+  observation.onlineDevices = 0;
+  observation.startingDevices = 0;
+  for (size_t i = 0; i < devices.size(); ++i) {
+    if (devices[i].isOnline() && !devices[i].isRetiring()) {
+      observation.onlineDevices++;
+    }
+    else if (eventQueue.contains(startupHandles[i])) {
+      observation.startingDevices++;
+    }
+  }
+
+  ScalingAction action = scaling.decide(observation, fromSimTime(lastScalingAction));
+  if (action == ScalingAction::SCALE_UP) {
+    scaleUp();
   }
+  else if (action == ScalingAction::SCALE_DOWN) {
+    scaleDown();
+  }
+
+  //   
+  occupancyArea = 0.0;
+  windowStart = currentTime;
+  windowGenerated = 0;
+  windowRejected = 0;
+  eventQueue.push(Event(currentTime + toSimTime(scaling.evaluationInterval), EventType::SCALING_CHECK, -1, -1));
+}
+
+void SimulationController::scaleUp() {
+  lastScalingAction = currentTime;
+  scaleUps++;
+
+  // ,        
+  for (Device& dev : devices) {
+    if (dev.isRetiring()) {
+      dev.setRetiring(false);
+      return;
+    }
+  }
+
+  //     ,  ,    
+  Device* target = nullptr;
+  for (size_t i = 0; i < devices.size(); ++i) {
+    if (!devices[i].isOnline() && !eventQueue.contains(startupHandles[i])) {
+      target = &devices[i];
+      break;
+    }
+  }
+  if (!target) {
+    int id = static_cast<int>(devices.size()) + 1;
+    if (serviceDistribution) {
+      devices.emplace_back(id, serviceDistribution);
+    }
+    else {
+      devices.emplace_back(id, meanServiceTime);
+    }
+    target = &devices.back();
+    applyServiceOverrides(*target);
+    target->takeOffline(0.0); //       0 -    
+    if (seed != 0) {
+      target->reseed(seed + 1000 + id);
+    }
+    dispatcher.addDevice(target);
+    completionHandles.push_back(EventHandle());
+    startupHandles.push_back(EventHandle());
+  }
+
+  int id = target->getDeviceId();
+  startupHandles[id - 1] = eventQueue.push(Event(currentTime + toSimTime(scaling.startupDelay), EventType::DEVICE_ONLINE, id, -1));
+}
+
+void SimulationController::scaleDown() {
+  //      ID,     -  ( )
+  Device* target = nullptr;
+  for (auto it = devices.rbegin(); it != devices.rend(); ++it) {
+    if (!it->isOnline() || it->isRetiring()) {
+      continue;
+    }
+    if (!it->getIsBusy()) {
+      target = &*it;
+      break;
+    }
+    if (!target) {
+      target = &*it;
+    }
+  }
+  if (!target) {
+    return;
+  }
+
+  lastScalingAction = currentTime;
+  scaleDowns++;
+  if (target->getIsBusy()) {
+    target->setRetiring(true);
+  }
+  else {
+    target->takeOffline(currentTime);
+  }
+}
+
+void SimulationController::handleDeviceOnline(const Event& event) {
+  devices[event.deviceId - 1].bringOnline(currentTime);
+  startupHandles[event.deviceId - 1] = EventHandle();
 }
 
 //   (1)
 void SimulationController::printSummary() {
-  std::cout << "\n---------------    (1) ---------------\n" << std::endl;
+  *output << "\n---------------    (1) ---------------\n" << std::endl;
 
-  std::cout << " 1:   ." << std::endl;
-  std::cout << std::setw(10) << "   " << std::setw(15) << " " << std::setw(15) << "P" << std::setw(15) << "T" << std::setw(15) << "T" << std::setw(15) << "T" << std::setw(15) << "" << std::setw(15) << "" << std::endl;
+  *output << " 1:   ." << std::endl;
+  *output << std::setw(10) << "   " << std::setw(15) << " " << std::setw(15) << "P" << std::setw(15) << "T" << std::setw(15) << "T" << std::setw(15) << "T" << std::setw(15) << "" << std::setw(15) << "" << std::endl;
 
-  for (int i = 1; i <= 3; ++i) {
+  //        -   
+  for (const auto& sourceEntry : requestsBySource) {
+    int i = sourceEntry.first;
     double p_otk = (requestsBySource[i] > 0) ? static_cast<double>(rejectedBySource[i]) / requestsBySource[i] : 0.0;
-    double t_pr = (completedBySource[i] > 0) ? totalTimeInSystem[i] / completedBySource[i] : 0.0;
-    double t_bp = (completedBySource[i] > 0) ? totalTimeWaiting[i] / completedBySource[i] : 0.0;
-    double t_obsl = (completedBySource[i] > 0) ? totalTimeProcessing[i] / completedBySource[i] : 0.0;
+    double t_pr = (completedBySource[i] > 0) ? fromSimTime(totalTimeInSystem[i]) / completedBySource[i] : 0.0;
+    double t_bp = (completedBySource[i] > 0) ? fromSimTime(totalTimeWaiting[i]) / completedBySource[i] : 0.0;
+    double t_obsl = (completedBySource[i] > 0) ? fromSimTime(totalTimeProcessing[i]) / completedBySource[i] : 0.0;
     double d_bp = (completedBySource[i] > 1) ? sumSqDiffWaitingTime[i] / (completedBySource[i] - 1) : 0.0; //  
     double d_obsl = (completedBySource[i] > 1) ? sumSqDiffProcessingTime[i] / (completedBySource[i] - 1) : 0.0; //  
 
-    std::cout << std::setw(10) << "" << i << std::setw(15) << requestsBySource[i] << std::setw(15) << std::fixed << std::setprecision(4) << p_otk
+    *output << std::setw(10) << "" << i << std::setw(15) << requestsBySource[i] << std::setw(15) << std::fixed << std::setprecision(4) << p_otk
       << std::setw(15) << t_pr << std::setw(15) << t_bp << std::setw(15) << t_obsl
       << std::setw(15) << d_bp << std::setw(15) << d_obsl << std::endl;
   }
-  std::cout << std::endl;
+  *output << std::endl;
+
+  if (preemption != PreemptionMode::NONE) {
+    *output << " : " << totalPreemptions << std::endl << std::endl;
+  }
 
-  std::cout << " 2:   ." << std::endl;
-  std::cout << std::setw(10) << "   " << std::setw(25) << " " << std::endl;
+  *output << " 2:   ." << std::endl;
+  *output << std::setw(10) << "   " << std::setw(25) << " ";
+  if (scaling.enabled) {
+    *output << std::setw(20) << "  ";
+  }
+  *output << std::endl;
+
+  //     ,    
+  SimTime observedEnd = std::min(currentTime, simulationEndTime);
+  double deviceTimeOnline = 0.0;
+  for (const Device& dev : devices) {
+    double timeOnline = fromSimTime(dev.getTotalTimeOnline(observedEnd));
+    deviceTimeOnline += timeOnline;
+    double k_isp = (timeOnline > 0.0) ? fromSimTime(dev.getTotalTimeBusy()) / timeOnline : 0.0;
+    *output << std::setw(10) << "" << dev.getDeviceId() << std::setw(25) << std::fixed << std::setprecision(4) << k_isp;
+    if (scaling.enabled) {
+      *output << std::setw(20) << timeOnline;
+    }
+    *output << std::endl;
+  }
 
-  for (int i = 1; i <= 3; ++i) {
-    double k_isp = devices[i - 1].getTotalTimeBusy() / simulationEndTime;
-    std::cout << std::setw(10) << "" << i << std::setw(25) << std::fixed << std::setprecision(4) << k_isp << std::endl;
+  if (scaling.enabled) {
+    *output << "\n :  " << scaleUps << ",  " << scaleDowns
+      << ",      " << std::setprecision(2) << ((observedEnd > 0) ? deviceTimeOnline / fromSimTime(observedEnd) : 0.0) << std::endl;
   }
 
-  std::cout << "\n-----------------------------------------------------------------\n" << std::endl;
+  //  3        (EDF,  ).
+  //        
+  const SelectionPolicy& policy = buffer.getSelectionPolicy();
+  if (policy.discipline != SelectionDiscipline::LIFO_PRIORITY) {
+    static const char* disciplineNames[] = { "D24", "EDF", " " };
+    *output << "\n 3:    (  : " << disciplineNames[static_cast<int>(policy.discipline)] << ")." << std::endl;
+    *output << std::setw(10) << "   " << std::setw(15) << "" << std::setw(15) << "P" << std::setw(15) << "T 99%" << std::endl;
+    for (const auto& sourceEntry : requestsBySource) {
+      int i = sourceEntry.first;
+      Priority p = priorityBySource.count(i) ? priorityBySource[i] : Priority::PRIVATE;
+      double p_miss = (completedBySource[i] > 0) ? static_cast<double>(deadlineMissesBySource[i]) / completedBySource[i] : 0.0;
+      double p99 = waitingP99.count(i) ? waitingP99[i].getValue() : 0.0;
+      *output << std::setw(10) << "" << i << std::setw(15) << std::fixed << std::setprecision(4) << policy.deadlineFor(p)
+        << std::setw(15) << p_miss << std::setw(15) << p99 << std::endl;
+    }
+  }
+  *output << "\n-----------------------------------------------------------------\n" << std::endl;
 }
\ No newline at end of file
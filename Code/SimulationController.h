@@ -5,40 +5,109 @@
 #include "Buffer.h"
 #include "Device.h"
 #include "Dispatcher.h"
+#include "TraceSource.h"
+#include "EventCalendar.h"
+#include "ScalingPolicy.h"
+#include "Statistics.h"
 #include <vector>
-#include <queue>
+#include <deque>
 #include <map>
 #include <string>
 #include <iostream>
-#include <csignal>
-
-struct Event {
-  double time;          //  
-  std::string type;     //   (GENERATION, SERVICE_COMPLETE)
-  int sourceId;         // ID  ( GENERATION)
-  int deviceId;         // ID  ( SERVICE_COMPLETE)
-  int requestId;        // ID 
-  Request request;      //   ( GENERATION)
-
-  //    
-  Event(double t, const std::string& ty, int srcId, int reqId, const Request& req)
-    : time(t), type(ty), sourceId(srcId), deviceId(-1), requestId(reqId), request(req) {}
-
-  //     
-  Event(double t, const std::string& ty, int devId, int reqId)
-    : time(t), type(ty), sourceId(-1), deviceId(devId), requestId(reqId) {}
-
-  //      (  -  )
-  bool operator>(const Event& other) const {
-    return time > other.time;
+#include <memory>
+#include <atomic>
+
+//       
+enum class PreemptionMode {
+  NONE,     //   (D24     )
+  RESUME,   //     
+  REPEAT    //         
+};
+
+//   
+struct SourceConfig {
+  double interval;      //    
+  Priority priority;    //  
+  std::shared_ptr<const Distribution> intervalDistribution; // nullptr -   [0, 2 * interval]
+  std::shared_ptr<const ArrivalProfile> arrivalProfile;     //  ,    
+
+  SourceConfig(double meanInterval, Priority pri, std::shared_ptr<const Distribution> distribution = nullptr)
+    : interval(meanInterval), priority(pri), intervalDistribution(distribution) {}
+};
+
+//   .     ,   
+//          
+class CancellationToken {
+private:
+  std::shared_ptr<std::atomic<bool>> flag;
+
+public:
+  CancellationToken() : flag(std::make_shared<std::atomic<bool>>(false)) {}
+  void cancel() const { flag->store(true, std::memory_order_relaxed); }
+  bool isCancelled() const { return flag->load(std::memory_order_relaxed); }
+};
+
+//  
+struct SimulationConfig {
+  int deviceCount;          //  
+  int bufferSize;           //  
+  double simulationEndTime; //   
+  double meanServiceTime;   //   
+  unsigned seed;            //   , 0 -   
+  PreemptionMode preemption; //     
+  std::vector<SourceConfig> sources; //  (ID     1)
+  std::shared_ptr<const Distribution> serviceDistribution; // nullptr -    meanServiceTime
+  ScalingPolicy scaling;     //    (  , deviceCount -  )
+  SelectionPolicy selection; //         
+  bool externalArrivals;     //    (submitArrival),     
+
+  SimulationConfig() : deviceCount(3), bufferSize(5), simulationEndTime(1000.0), meanServiceTime(10.0), seed(0), preemption(PreemptionMode::NONE),
+    externalArrivals(false) {
+    sources.emplace_back(10.0, Priority::WARRANTY);  //  1:  ( )
+    sources.emplace_back(7.0, Priority::CORPORATE);  //  2:  ( )
+    sources.emplace_back(5.0, Priority::PRIVATE);    //  3:  ( )
   }
 };
 
+//    
+struct SourceResults {
+  int sourceId;
+  Priority priority;
+  int generated;
+  int rejected;
+  int completed;
+  double rejectionProbability; // P 
+  double meanTimeInSystem;     // T 
+  double meanWaiting;          // T 
+  double meanProcessing;       // T 
+  double waitingVariance;      //   ( )
+  double processingVariance;   //   ( )
+  double p99Waiting;           // 99-  T 
+  double deadlineMissRate;     //   ,     
+};
+
+//    ,    
+struct SimulationResults {
+  std::vector<SourceResults> sources;
+  std::vector<double> deviceUtilization; //    (   )
+  double meanOnlineDevices;              //     
+  int scaleUps;                          //    
+  int scaleDowns;                        //  
+  int preemptions;                       //  
+  double p99Waiting;                     // 99-  T    
+
+  //        
+  double rejectionProbability(Priority p) const;
+};
+
+//   .     ,
+//         
 class SimulationController {
 private:
   std::vector<Source> sources;      //  
   Buffer buffer;                    // 
-  std::vector<Device> devices;      //  
+  std::deque<Device> devices;       // .      , 
+                                    //    ID ( + 1)  
   Dispatcher dispatcher;            // 
 
   // 
@@ -48,51 +117,204 @@ private:
   std::map<int, int> requestsBySource;      //    
   std::map<int, int> rejectedBySource;      //     
   std::map<int, int> completedBySource;     //     
-  std::map<int, double> totalTimeInSystem;  //      
-  std::map<int, double> totalTimeWaiting;   //     
-  std::map<int, double> totalTimeProcessing; //     
+  std::map<int, SimTime> totalTimeInSystem;  //      
+  std::map<int, SimTime> totalTimeWaiting;   //     
+  std::map<int, SimTime> totalTimeProcessing; //     
 
   //       (T )
   std::map<int, double> sumSqDiffWaitingTime;
   //       (T )
   std::map<int, double> sumSqDiffProcessingTime;
 
+  //  99-  T        (     )
+  std::map<int, P2Quantile> waitingP99;
+  P2Quantile allWaitingP99;
+  //    
+  std::map<int, Priority> priorityBySource;
+  //       
+  std::map<int, int> deadlineMissesBySource;
+
   //  
-  std::priority_queue<Event, std::vector<Event>, std::greater<Event>> eventQueue;
+  EventCalendar eventQueue;
+  //       ( - ID  - 1)
+  std::vector<EventHandle> completionHandles;
+  //       ( - ID  - 1)
+  std::vector<EventHandle> startupHandles;
+  //    ( - ID  - 1),      
+  std::vector<EventHandle> firstArrivalHandles;
 
   //   
-  double currentTime;
+  SimTime currentTime;
 
   //  
-  double simulationEndTime; //   
+  SimTime simulationEndTime; //   
   int bufferSize;           //  
   double meanServiceTime;   //   
+  int deviceCount;          //  
+  unsigned seed;            //   , 0 -   
+  PreemptionMode preemption; //   
+  int totalPreemptions;     //   
+  bool externalArrivals;    //   ,    
+  std::vector<SourceConfig> sourceConfigs;                 //  
+  std::shared_ptr<const Distribution> serviceDistribution; //   
+
+  std::ostream* output;     //      
+  CancellationToken cancellation; //  
+  long long eventsProcessed; //   
+
+  //   
+  ScalingPolicy scaling;
+  SimTime lastScalingAction; //    
+  double occupancyArea;      //        
+  SimTime occupancyMark;     //    
+  SimTime windowStart;       //    
+  int windowGenerated;       //    
+  int windowRejected;        //   
+  int scaleUps;
+  int scaleDowns;
+
+  //  ,     (ID  -> ).
+  // ,     ,    
+  struct DeviceServiceOverride {
+    std::shared_ptr<const Distribution> all;
+    std::shared_ptr<const Distribution> byPriority[3];
+  };
+  std::map<int, DeviceServiceOverride> deviceServiceOverrides;
 
   //    ID 
   int nextRequestId;
 
+  //   ( ), nullptr -  
+  std::unique_ptr<TraceSource> traceSource;
+  //           : 
+  //      ,      
+  bool traceBatchOpen;
+
+  //    (   )
+  std::vector<AssignmentResult> pendingAssignments;
+
+  //    (   )
+  std::vector<Event> currentBatch;
+
 public:
-  SimulationController();
+  explicit SimulationController(const SimulationConfig& config = SimulationConfig());
 
   void runSimulationStepByStep(); //   (1)
   void runSimulationAutomatic();  //   (1)
 
+  //        
+  void runToCompletion();
+
+  //        eventCount  (    
+  //  ).    
+  long long runForEvents(long long eventCount);
+
+  //       untilTime (    )
+  void runUntil(double untilTime);
+
+  // true,          
+  bool isFinished() const;
+
+  double getCurrentTime() const { return fromSimTime(currentTime); }
+  //     (simTimeInfinity(),   )
+  SimTime getNextEventTime() const { return eventQueue.empty() ? simTimeInfinity() : eventQueue.top().time; }
+  //      
+  int getRequestsInSystem() const { return totalRequestsGenerated - totalRequestsRejected - totalRequestsCompleted; }
+  long long getEventsProcessed() const { return eventsProcessed; }
+
+  //      (  std::cout)
+  void setOutput(std::ostream& stream) { output = &stream; }
+
+  //   : cancel()     
+  const CancellationToken& getCancellationToken() const { return cancellation; }
+  //      (,    )
+  void setCancellationToken(const CancellationToken& token) { cancellation = token; }
+  void cancel() { cancellation.cancel(); }
+
+  //     
+  SimulationResults getResults() const;
+
   //      
   bool stepSimulation();
 
+  //    :       ( 
+  // ,  ).     , 
+  //      
+  bool stepSimulationBatch();
+
   //       (1)
   void printCurrentState();
 
   //       (1)
   void printSummary();
 
+  //     (ID /   1).
+  //       .  
+  //     ,     (ID  maxDevices):
+  //      
+  void setDeviceServiceDistribution(int deviceId, std::shared_ptr<const Distribution> distribution);
+  void setDeviceServiceDistribution(int deviceId, Priority p, std::shared_ptr<const Distribution> distribution);
+  void setSourceIntervalDistribution(int sourceId, std::shared_ptr<const Distribution> distribution);
+  //      .       :
+  //      
+  void setSourceArrivalProfile(int sourceId, std::shared_ptr<const ArrivalProfile> profile);
+
+  //        .
+  //     ( std::logic_error);     
+  void loadTrace(const std::vector<std::string>& paths);
+
+  //       ( externalArrivals).  
+  //          
+  void submitArrival(const Request& req);
+
+  void setSimulationEndTime(double endTime) { simulationEndTime = toSimTime(endTime); }
+
+private:
   //    
   void initializeSystem();
 
+  //         
+  bool scheduleNextTraceArrival();
+  //        
+  Event makeTraceArrival(const TraceRecord& record);
+
+  //         
+  EventHandle scheduleNextGeneration(Source& source);
+
+  //         
+  void advanceTime(SimTime time);
+
+  //        ,      
+  void finishAtEndTime();
+
+  //      
+  void handleEvent(const Event& event);
+
+  //    
+  void handleScalingCheck();
+  void handleDeviceOnline(const Event& event);
+  void scaleUp();
+  void scaleDown();
+  //       
+  void applyServiceOverrides(Device& device);
+  //       
+  void recordRejection(const Request& rejected);
+
   //      
   void handleGenerationEvent(const Event& event);
   void handleServiceCompleteEvent(const Event& event);
 
+  //   :    
+  //       
+  void dispatchPending();
+
+  //       
+  void scheduleServiceCompletion(const AssignmentResult& assignment);
+
+  //       ,   
+  //      ,     
+  void preemptLowerPriorityService();
+
 };
 
 #endif
\ No newline at end of file
@@ -8,16 +8,19 @@ Source::Source(int id, double interval, Priority pri)
   generator.seed(seed + id);
 
   //     
-  distribution = std::uniform_real_distribution<double>(0.0, 2.0 * generationInterval);
+  distribution = OwnedDistribution(UniformDistribution(0.0, 2.0 * generationInterval));
 }
 
-Request Source::generateRequest(double currentTime, int uniqueId) {
+Request Source::generateRequest(SimTime currentTime, int uniqueId) {
   Request req(uniqueId, sourceId, currentTime, priority);
   return req;
 }
 
-double Source::getNextGenerationTime(double currentTime) {
+SimTime Source::getNextGenerationTime(SimTime currentTime) {
+  if (profile) {
+    return toSimTime(profile->nextArrival(fromSimTime(currentTime), generator));
+  }
   // C    
-  double nextInterval = distribution(generator);
-  return currentTime + nextInterval;
+  double nextInterval = distribution->sample(generator);
+  return currentTime + toSimTime(nextInterval);
 }
\ No newline at end of file
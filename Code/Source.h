@@ -2,7 +2,10 @@
 #define SOURCE_H
 
 #include <random>
+#include <memory>
 #include "Request.h"
+#include "Distribution.h"
+#include "ArrivalProfile.h"
 
 class Source {
 private:
@@ -10,16 +13,27 @@ private:
   double generationInterval; //     
   Priority priority;      //  
   std::default_random_engine generator; //   
-  std::uniform_real_distribution<double> distribution; //  
+  OwnedDistribution distribution; //   (  ),   
+  std::shared_ptr<const ArrivalProfile> profile;    //   (nullptr -  )
 
 public:
   Source(int id, double interval, Priority pri);
 
   //     
-  Request generateRequest(double currentTime, int uniqueId);
+  Request generateRequest(SimTime currentTime, int uniqueId);
 
   //      
-  double getNextGenerationTime(double currentTime);
+  SimTime getNextGenerationTime(SimTime currentTime);
+
+  //       
+  void setIntervalDistribution(std::shared_ptr<const Distribution> intervalDistribution) { distribution = OwnedDistribution(*intervalDistribution); }
+
+  //     .    :
+  //     
+  void setArrivalProfile(std::shared_ptr<const ArrivalProfile> arrivalProfile) { profile = arrivalProfile; }
+
+  //       ( )
+  void reseed(unsigned seed) { generator.seed(seed); }
 
   int getSourceId() const { return sourceId; }
   Priority getPriority() const { return priority; }
@@ -0,0 +1,199 @@
+#include "Statistics.h"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+}
+
+double normalQuantile(double probability) {
+  if (probability <= 0.0 || probability >= 1.0) {
+    throw std::invalid_argument("  :   (0, 1).");
+  }
+  //    (  ~1e-9)     
+  static const double a[] = { -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+    1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00 };
+  static const double b[] = { -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+    6.680131188771972e+01, -1.328068155288572e+01 };
+  static const double c[] = { -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+    -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00 };
+  static const double d[] = { 7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+    3.754408661907416e+00 };
+  const double low = 0.02425;
+
+  double x;
+  if (probability < low) {
+    double q = std::sqrt(-2.0 * std::log(probability));
+    x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+      ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+  }
+  else if (probability <= 1.0 - low) {
+    double q = probability - 0.5;
+    double r = q * q;
+    x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+      (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+  }
+  else {
+    double q = std::sqrt(-2.0 * std::log(1.0 - probability));
+    x = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+      ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+  }
+
+  double e = 0.5 * std::erfc(-x / std::sqrt(2.0)) - probability;
+  double u = e * std::sqrt(2.0 * PI) * std::exp(x * x / 2.0);
+  return x - u / (1.0 + x * u / 2.0);
+}
+
+double studentQuantile(int degreesOfFreedom, double alpha) {
+  if (alpha <= 0.0 || alpha >= 1.0) {
+    throw std::invalid_argument(" :    (0, 1).");
+  }
+  int n = std::max(1, degreesOfFreedom);
+  if (n == 1) {
+    double angle = alpha * PI / 2.0;
+    return std::cos(angle) / std::sin(angle);
+  }
+  if (n == 2) {
+    return std::sqrt(2.0 / (alpha * (2.0 - alpha)) - 2.0);
+  }
+
+  //   (ACM 396)    alpha
+  double a = 1.0 / (n - 0.5);
+  double b = 48.0 / (a * a);
+  double c = ((20700.0 * a / b - 98.0) * a - 16.0) * a + 96.36;
+  double d = ((94.5 / (b + c) - 3.0) / b + 1.0) * std::sqrt(a * PI / 2.0) * n;
+  double x = d * alpha;
+  double y = std::pow(x, 2.0 / n);
+  if (y > 0.05 + a) {
+    //     
+    x = normalQuantile(0.5 * alpha);
+    y = x * x;
+    if (n < 5) {
+      c += 0.3 * (n - 4.5) * (x + 0.6);
+    }
+    c = (((0.05 * d * x - 5.0) * x - 7.0) * x - 2.0) * x + b + c;
+    y = (((((0.4 * y + 6.3) * y + 36.0) * y + 94.5) / c - y - 3.0) / b + 1.0) * x;
+    y = a * y * y;
+    y = (y > 0.002) ? std::exp(y) - 1.0 : 0.5 * y * y + y;
+  }
+  else {
+    y = ((1.0 / (((n + 6.0) / (n * y) - 0.089 * d - 0.822) * (n + 2.0) * 3.0) + 0.5 / (n + 4.0)) * y - 1.0) *
+      (n + 1.0) / (n + 2.0) + 1.0 / y;
+  }
+  return std::sqrt(n * y);
+}
+
+double sampleMean(const std::vector<double>& values) {
+  double sum = 0.0;
+  for (double v : values) {
+    sum += v;
+  }
+  return values.empty() ? 0.0 : sum / values.size();
+}
+
+double confidenceHalfWidth(const std::vector<double>& values, double alpha) {
+  size_t n = values.size();
+  if (n < 2) {
+    return 0.0;
+  }
+  double m = sampleMean(values);
+  double sumSq = 0.0;
+  for (double v : values) {
+    sumSq += (v - m) * (v - m);
+  }
+  return studentQuantile(static_cast<int>(n) - 1, alpha) * std::sqrt(sumSq / (n - 1) / n);
+}
+
+P2Quantile::P2Quantile(double q) : quantile(q), count(0) {
+  if (q <= 0.0 || q >= 1.0) {
+    throw std::invalid_argument(" :   (0, 1).");
+  }
+  for (int i = 0; i < 5; ++i) {
+    heights[i] = 0.0;
+    positions[i] = i + 1.0;
+  }
+  desired[0] = 1.0;
+  desired[1] = 1.0 + 2.0 * q;
+  desired[2] = 1.0 + 4.0 * q;
+  desired[3] = 3.0 + 2.0 * q;
+  desired[4] = 5.0;
+  increments[0] = 0.0;
+  increments[1] = q / 2.0;
+  increments[2] = q;
+  increments[3] = (1.0 + q) / 2.0;
+  increments[4] = 1.0;
+}
+
+double P2Quantile::parabolic(int i, double direction) const {
+  return heights[i] + direction / (positions[i + 1] - positions[i - 1]) *
+    ((positions[i] - positions[i - 1] + direction) * (heights[i + 1] - heights[i]) / (positions[i + 1] - positions[i]) +
+      (positions[i + 1] - positions[i] - direction) * (heights[i] - heights[i - 1]) / (positions[i] - positions[i - 1]));
+}
+
+double P2Quantile::linear(int i, double direction) const {
+  int j = i + static_cast<int>(direction);
+  return heights[i] + direction * (heights[j] - heights[i]) / (positions[j] - positions[i]);
+}
+
+void P2Quantile::add(double value) {
+  //       
+  if (count < 5) {
+    heights[count++] = value;
+    if (count == 5) {
+      std::sort(heights, heights + 5);
+    }
+    return;
+  }
+  ++count;
+
+  // ,    ;       
+  int cell;
+  if (value < heights[0]) {
+    heights[0] = value;
+    cell = 0;
+  }
+  else if (value >= heights[4]) {
+    heights[4] = value;
+    cell = 3;
+  }
+  else {
+    cell = 0;
+    while (value >= heights[cell + 1]) {
+      ++cell;
+    }
+  }
+  for (int i = cell + 1; i < 5; ++i) {
+    positions[i] += 1.0;
+  }
+  for (int i = 0; i < 5; ++i) {
+    desired[i] += increments[i];
+  }
+
+  //           
+  for (int i = 1; i < 4; ++i) {
+    double shift = desired[i] - positions[i];
+    if ((shift >= 1.0 && positions[i + 1] - positions[i] > 1.0) || (shift <= -1.0 && positions[i - 1] - positions[i] < -1.0)) {
+      double direction = (shift > 0.0) ? 1.0 : -1.0;
+      double candidate = parabolic(i, direction);
+      heights[i] = (heights[i - 1] < candidate && candidate < heights[i + 1]) ? candidate : linear(i, direction);
+      positions[i] += direction;
+    }
+  }
+}
+
+double P2Quantile::getValue() const {
+  if (count == 0) {
+    return 0.0;
+  }
+  if (count < 5) {
+    //     ceil(q * n)
+    std::vector<double> sorted(heights, heights + count);
+    std::sort(sorted.begin(), sorted.end());
+    long long k = static_cast<long long>(std::ceil(quantile * count));
+    return sorted[(k == 0) ? 0 : k - 1];
+  }
+  return heights[2];
+}
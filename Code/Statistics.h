@@ -0,0 +1,46 @@
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+#include <vector>
+
+//      probability (0 < probability < 1)
+double normalQuantile(double probability);
+
+//  t-        alpha
+// (  0.05 -  0.975)
+double studentQuantile(int degreesOfFreedom, double alpha = 0.05);
+
+//   (0   )
+double sampleMean(const std::vector<double>& values);
+
+//          alpha
+// (0     )
+double confidenceHalfWidth(const std::vector<double>& values, double alpha = 0.05);
+
+//      P^2 (, ):  ,
+//  O(1)    .     
+class P2Quantile {
+private:
+  double quantile;
+  long long count;
+  double heights[5];   //   (  0, q/2, q, (1+q)/2, 1)
+  double positions[5]; //   
+  double desired[5];   //  
+  double increments[5]; //      
+
+  double parabolic(int i, double direction) const;
+  double linear(int i, double direction) const;
+
+public:
+  explicit P2Quantile(double q = 0.99);
+
+  //     
+  void add(double value);
+
+  //    (0  )
+  double getValue() const;
+
+  long long getCount() const { return count; }
+};
+
+#endif
@@ -0,0 +1,127 @@
+//   :  ,  ,   
+//    ,       .
+//      Code:
+//   g++ -std=c++17 -O2 -pthread -I. Tests/ArrivalProfileTest.cpp $(ls *.cpp | grep -v main.cpp) -o arrival_profile_test && ./arrival_profile_test
+#include "ArrivalProfile.h"
+#include "TestUtil.h"
+#include <cmath>
+#include <random>
+#include <vector>
+#include <string>
+
+namespace {
+
+//   horizon,    [edges[i], edges[i+1])  
+std::vector<int> countArrivals(const ArrivalProfile& profile, double horizon, const std::vector<double>& edges, unsigned seed) {
+  std::default_random_engine generator(seed);
+  std::vector<int> counts(edges.size() - 1, 0);
+  double period = profile.getPeriod();
+  double t = profile.nextArrival(0.0, generator);
+  while (t < horizon) {
+    double local = (period > 0.0) ? t - std::floor(t / period) * period : t;
+    for (size_t i = 0; i + 1 < edges.size(); ++i) {
+      if (local >= edges[i] && local < edges[i + 1]) {
+        counts[i]++;
+        break;
+      }
+    }
+    t = profile.nextArrival(t, generator);
+  }
+  return counts;
+}
+
+//   :    5  ,
+//       
+void expectPoissonCount(int count, double expected, const std::string& name) {
+  bool ok = (expected == 0.0) ? count == 0 : std::fabs(count - expected) <= 5.0 * std::sqrt(expected);
+  expect(ok, name + ":  " + std::to_string(count) + ",  " + std::to_string(expected));
+}
+
+//       :     ,
+//  -   
+void expectRatePerBin(const ArrivalProfile& profile, const std::vector<double>& edges, int periods, const std::string& name) {
+  std::vector<int> counts = countArrivals(profile, periods * profile.getPeriod(), edges, 7);
+  for (size_t i = 0; i + 1 < edges.size(); ++i) {
+    double left = profile.rateAt(edges[i]);
+    double right = (profile.getShape() == ProfileShape::PIECEWISE_CONSTANT) ? left : profile.rateAt(edges[i + 1]);
+    double expected = periods * (left + right) / 2.0 * (edges[i + 1] - edges[i]);
+    expectPoissonCount(counts[i], expected, name + ", [" + std::to_string(edges[i]) + ", " + std::to_string(edges[i + 1]) + ")");
+  }
+}
+
+void testPiecewiseConstantRate() {
+  //      
+  ArrivalProfile profile({ 0.0, 10.0, 20.0, 30.0 }, { 2.0, 0.0, 5.0, 1.0 }, ProfileShape::PIECEWISE_CONSTANT, 40.0);
+  expectRatePerBin(profile, { 0.0, 10.0, 20.0, 25.0, 30.0, 40.0 }, 2000, "- ");
+  expectNear(profile.getMeanRate(), 2.0, 1e-12, "  - ");
+}
+
+void testPiecewiseLinearRate() {
+  // ,           
+  ArrivalProfile profile({ 0.0, 10.0, 25.0 }, { 0.0, 4.0, 1.0 }, ProfileShape::PIECEWISE_LINEAR, 30.0);
+  std::vector<double> edges;
+  for (double e = 0.0; e <= 30.0; e += 2.5) {
+    edges.push_back(e);
+  }
+  expectRatePerBin(profile, edges, 3000, "- ");
+}
+
+//       :     
+void testNonPeriodicTail() {
+  ArrivalProfile falling({ 0.0, 10.0 }, { 4.0, 0.0 }, ProfileShape::PIECEWISE_LINEAR);
+  std::default_random_engine generator(11);
+  const int runs = 3000;
+  std::vector<int> counts(4, 0);
+  bool ends = true;
+  for (int run = 0; run < runs; ++run) {
+    double t = falling.nextArrival(0.0, generator);
+    while (std::isfinite(t)) {
+      ends = ends && t < 10.0;
+      counts[std::min(3, static_cast<int>(t / 2.5))]++;
+      t = falling.nextArrival(t, generator);
+    }
+  }
+  expect(ends, "     ");
+  for (int i = 0; i < 4; ++i) {
+    double expected = runs * (falling.rateAt(2.5 * i) + falling.rateAt(2.5 * (i + 1))) / 2.0 * 2.5;
+    expectPoissonCount(counts[i], expected, "   ,  " + std::to_string(i));
+  }
+
+  ArrivalProfile delayed({ 0.0, 5.0 }, { 0.0, 3.0 }, ProfileShape::PIECEWISE_CONSTANT);
+  std::vector<int> tail = countArrivals(delayed, 5005.0, { 0.0, 5.0, 5005.0 }, 13);
+  expectPoissonCount(tail[0], 0.0, "     ");
+  expectPoissonCount(tail[1], 15000.0, "     ");
+}
+
+void expectMajorantBounds(const ArrivalProfile& profile, double horizon, const std::string& name) {
+  bool bounded = true;
+  double worst = 0.0;
+  for (int i = 0; i <= 100000; ++i) {
+    double t = horizon * i / 100000.0;
+    double excess = profile.rateAt(t) - profile.majorantAt(t);
+    bounded = bounded && excess <= 1e-12;
+    worst = std::max(worst, excess);
+  }
+  expect(bounded, name + ":     " + std::to_string(worst));
+}
+
+void testMajorantBoundsRate() {
+  expectMajorantBounds(ArrivalProfile({ 0.0, 10.0, 20.0, 30.0 }, { 2.0, 0.0, 5.0, 1.0 }, ProfileShape::PIECEWISE_CONSTANT, 40.0),
+    120.0, "- ");
+  expectMajorantBounds(ArrivalProfile({ 0.0, 10.0, 25.0 }, { 0.0, 4.0, 1.0 }, ProfileShape::PIECEWISE_LINEAR, 30.0),
+    90.0, "- ");
+  //          
+  expectMajorantBounds(ArrivalProfile({ 0.0, 3.0, 7.0 }, { 6.0, 2.0, 0.5 }, ProfileShape::PIECEWISE_LINEAR, 12.0),
+    36.0, "   ");
+  expectMajorantBounds(ArrivalProfile({ 0.0, 10.0 }, { 4.0, 0.0 }, ProfileShape::PIECEWISE_LINEAR), 30.0, "  ");
+}
+
+}
+
+int main() {
+  testPiecewiseConstantRate();
+  testPiecewiseLinearRate();
+  testNonPeriodicTail();
+  testMajorantBoundsRate();
+  return testSummary("ArrivalProfile");
+}
@@ -0,0 +1,100 @@
+//     (stepSimulationBatch):     ,
+//     ,   ,        .
+//      Code:
+//   g++ -std=c++17 -O2 -pthread -I. Tests/BatchSteppingTest.cpp $(ls *.cpp | grep -v main.cpp) -o batch_stepping_test && ./batch_stepping_test
+#include "SimulationController.h"
+#include "TestUtil.h"
+#include <fstream>
+#include <cstdio>
+#include <string>
+
+namespace {
+
+const char* TRACE_PATH = "batch_stepping_test_trace.csv";
+
+void writeTrace(const std::string& rows) {
+  std::ofstream trace(TRACE_PATH);
+  trace << "time,source,priority,service\n" << rows;
+}
+
+SimulationConfig traceConfig(int deviceCount, int bufferSize) {
+  SimulationConfig config;
+  config.deviceCount = deviceCount;
+  config.bufferSize = bufferSize;
+  config.simulationEndTime = 100.0;
+  config.seed = 1;
+  return config;
+}
+
+//        1.0 -  ,   
+void testTraceBurstInOneBatch() {
+  writeTrace("1.0,1,2,10\n1.0,2,1,10\n1.0,3,0,10\n2.0,3,0,10\n");
+  {
+    std::ofstream second("batch_stepping_test_trace2.csv");
+    second << "1.0,2,1,10\n";
+  }
+
+  SimulationController controller(traceConfig(2, 5));
+  controller.loadTrace({ TRACE_PATH, "batch_stepping_test_trace2.csv" });
+  expect(controller.stepSimulationBatch(), " ");
+  expect(controller.getEventsProcessed() == 4 && controller.getRequestsInSystem() == 4,
+    "   1.0:  " + std::to_string(controller.getEventsProcessed()) + ",  4");
+  expect(controller.getNextEventTime() == toSimTime(2.0), "      ");
+
+  expect(controller.stepSimulationBatch(), " ");
+  expect(controller.getEventsProcessed() == 5 && controller.getCurrentTime() == 2.0, "   2.0   ");
+
+  controller.runToCompletion();
+  SimulationResults results = controller.getResults();
+  int generated = 0;
+  for (const SourceResults& s : results.sources) {
+    generated += s.generated;
+  }
+  expect(generated == 5, "      ");
+
+  std::remove(TRACE_PATH);
+  std::remove("batch_stepping_test_trace2.csv");
+}
+
+//     : 3 ,   2 .     
+//  ,     ,         
+void testBatchMatchesPerEvent(PreemptionMode preemption, const std::string& name) {
+  writeTrace("1.0,3,0,5\n1.0,3,0,5\n1.0,3,0,5\n1.0,3,0,5\n1.0,3,0,5\n1.0,3,0,5\n"
+    "3.0,1,2,2\n3.0,1,2,2\n3.0,2,1,2\n3.0,3,0,2\n3.0,3,0,2\n"
+    "20.0,2,1,1\n20.0,2,1,1\n20.0,3,0,1\n20.0,3,0,1\n20.0,3,0,1\n20.0,3,0,1\n");
+
+  SimulationConfig config = traceConfig(3, 2);
+  config.preemption = preemption;
+  SimulationController batch(config);
+  batch.loadTrace({ TRACE_PATH });
+  //   6   3      2   ,   
+  batch.stepSimulationBatch();
+  expect(batch.getRequestsInSystem() == 5, name + ":     ,   " +
+    std::to_string(batch.getRequestsInSystem()) + " ,  5");
+  batch.runToCompletion();
+  SimulationController perEvent(config);
+  perEvent.loadTrace({ TRACE_PATH });
+  while (perEvent.stepSimulation()) {
+  }
+  std::remove(TRACE_PATH);
+
+  SimulationResults a = batch.getResults();
+  SimulationResults b = perEvent.getResults();
+  bool same = a.sources.size() == b.sources.size() && a.preemptions == b.preemptions;
+  for (size_t i = 0; same && i < a.sources.size(); ++i) {
+    const SourceResults& x = a.sources[i];
+    const SourceResults& y = b.sources[i];
+    same = x.sourceId == y.sourceId && x.generated == y.generated && x.rejected == y.rejected && x.completed == y.completed &&
+      x.meanTimeInSystem == y.meanTimeInSystem && x.meanWaiting == y.meanWaiting && x.meanProcessing == y.meanProcessing;
+  }
+  expect(same, name + ":        ");
+}
+
+}
+
+int main() {
+  testTraceBurstInOneBatch();
+  testBatchMatchesPerEvent(PreemptionMode::NONE, " ");
+  testBatchMatchesPerEvent(PreemptionMode::RESUME, " ");
+  return testSummary("BatchStepping");
+}
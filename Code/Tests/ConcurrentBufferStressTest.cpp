@@ -0,0 +1,280 @@
+//   ConcurrentBuffer:      ,   ,
+//        Buffer.
+//      Code:
+//   g++ -std=c++17 -O2 -pthread -I. Tests/ConcurrentBufferStressTest.cpp ConcurrentBuffer.cpp Request.cpp -o buffer_stress && ./buffer_stress
+//        -  -fsanitize=address  -fsanitize=thread
+#include "ConcurrentBuffer.h"
+#include "TestUtil.h"
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+Priority priorityOf(int requestId) {
+  return static_cast<Priority>(requestId % 3);
+}
+
+//       Buffer: D1004  , D24  
+void testSequentialContract() {
+  ConcurrentBuffer buffer(3, 2);
+  Request replaced;
+
+  buffer.addRequest(Request(1, 3, 0, Priority::PRIVATE), replaced);
+  buffer.addRequest(Request(2, 1, 0, Priority::WARRANTY), replaced);
+  buffer.addRequest(Request(3, 3, 0, Priority::PRIVATE), replaced);
+  expect(buffer.isFull(), "   ");
+  expect(replaced.getRequestId() == 0, "     ");
+
+  buffer.addRequest(Request(4, 2, 0, Priority::CORPORATE), replaced);
+  expect(replaced.getRequestId() == 3 && replaced.getStatus() == RequestStatus::REJECTED,
+    "      (#3)");
+  expect(buffer.getCurrentSize() == 3, "   ");
+
+  const int expectedOrder[] = { 2, 4, 1 };
+  for (int id : expectedOrder) {
+    Request taken;
+    expect(buffer.takeRequest(taken) && taken.getRequestId() == id, "  D24:  #" + std::to_string(id));
+  }
+  Request none;
+  expect(!buffer.takeRequest(none) && buffer.isEmpty(), "     ");
+}
+
+//     .         :
+//  ,  ,      
+void testStress(int capacity, int shardsPerPriority, int producerCount, int consumerCount, int requestsPerProducer) {
+  ConcurrentBuffer buffer(capacity, shardsPerPriority);
+  int totalRequests = producerCount * requestsPerProducer;
+  std::vector<std::atomic<int>> seen(totalRequests + 1);
+  for (auto& counter : seen) {
+    counter.store(0);
+  }
+  std::atomic<int> producersRunning(producerCount);
+  std::atomic<long long> taken(0);
+  std::atomic<long long> rejected(0);
+  std::atomic<bool> sizeExceeded(false);
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producerCount; ++p) {
+    threads.emplace_back([&, p]() {
+      for (int i = 0; i < requestsPerProducer; ++i) {
+        int id = p * requestsPerProducer + i + 1;
+        Request replaced;
+        buffer.addRequest(Request(id, p + 1, 0, priorityOf(id)), replaced);
+        if (replaced.getStatus() == RequestStatus::REJECTED) {
+          seen[replaced.getRequestId()].fetch_add(1);
+          rejected.fetch_add(1);
+        }
+        if (buffer.getCurrentSize() > capacity) {
+          sizeExceeded = true;
+        }
+      }
+      producersRunning.fetch_sub(1);
+    });
+  }
+  for (int c = 0; c < consumerCount; ++c) {
+    threads.emplace_back([&]() {
+      Request req;
+      while (producersRunning.load() > 0) {
+        if (buffer.takeRequest(req)) {
+          seen[req.getRequestId()].fetch_add(1);
+          taken.fetch_add(1);
+        }
+        else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  long long remaining = 0;
+  Request req;
+  while (buffer.takeRequest(req)) {
+    seen[req.getRequestId()].fetch_add(1);
+    ++remaining;
+  }
+
+  std::string name = " " + std::to_string(capacity) + ",  " + std::to_string(shardsPerPriority)
+    + ",  " + std::to_string(producerCount) + ",  " + std::to_string(consumerCount);
+  int lost = 0;
+  int duplicated = 0;
+  for (int id = 1; id <= totalRequests; ++id) {
+    if (seen[id] == 0) ++lost;
+    if (seen[id] > 1) ++duplicated;
+  }
+  expect(lost == 0, name + ":   " + std::to_string(lost));
+  expect(duplicated == 0, name + ":    " + std::to_string(duplicated));
+  expect(taken + rejected + remaining == totalRequests, name + ": ,       ");
+  expect(remaining <= capacity, name + ":      ,  ");
+  expect(!sizeExceeded, name + ":   ");
+  expect(buffer.getCurrentSize() == 0 && buffer.isEmpty(), name + ":      ");
+}
+
+//  :  [invoked, responded]      
+struct HistoryOp {
+  bool add;
+  int requestId;      //   (add)
+  Priority priority;
+  int result;         // add -   , take -  ; 0 - 
+  long long invoked;
+  long long responded;
+};
+
+//   :     
+struct SpecState {
+  struct Item {
+    int requestId;
+    Priority priority;
+    int order;
+  };
+  std::vector<Item> items;
+  int nextOrder = 0;
+};
+
+//   Buffer: D1004  , D24  .   -
+//      ,    (reservedAdds)
+bool applySpec(SpecState& state, const HistoryOp& op, int capacity, int reservedAdds) {
+  auto latest = [](const SpecState::Item& a, const SpecState::Item& b) { return a.order < b.order; };
+  if (op.add) {
+    int evicted = 0;
+    int occupied = static_cast<int>(state.items.size());
+    if (occupied >= capacity || (op.result != 0 && occupied + reservedAdds >= capacity && occupied > 0)) {
+      auto victim = std::max_element(state.items.begin(), state.items.end(), latest);
+      evicted = victim->requestId;
+      state.items.erase(victim);
+    }
+    if (evicted != op.result) {
+      return false;
+    }
+    state.items.push_back(SpecState::Item{ op.requestId, op.priority, state.nextOrder++ });
+    return true;
+  }
+  if (state.items.empty()) {
+    return op.result == 0;
+  }
+  auto best = std::max_element(state.items.begin(), state.items.end(), [&](const SpecState::Item& a, const SpecState::Item& b) {
+    return a.priority != b.priority ? a.priority < b.priority : latest(a, b);
+  });
+  if (best->requestId != op.result) {
+    return false;
+  }
+  state.items.erase(best);
+  return true;
+}
+
+//   :     ,  , 
+//     
+bool linearize(const SpecState& state, const std::vector<HistoryOp>& ops, std::vector<bool>& done, int left, int capacity) {
+  if (left == 0) {
+    return true;
+  }
+  long long earliestResponse = std::numeric_limits<long long>::max();
+  for (size_t i = 0; i < ops.size(); ++i) {
+    if (!done[i]) {
+      earliestResponse = std::min(earliestResponse, ops[i].responded);
+    }
+  }
+  for (size_t i = 0; i < ops.size(); ++i) {
+    if (done[i] || ops[i].invoked > earliestResponse) {
+      continue;
+    }
+    int reservedAdds = 0;
+    for (size_t j = 0; j < ops.size(); ++j) {
+      if (!done[j] && j != i && ops[j].add && ops[j].invoked < ops[i].responded) {
+        ++reservedAdds;
+      }
+    }
+    SpecState next = state;
+    if (!applySpec(next, ops[i], capacity, reservedAdds)) {
+      continue;
+    }
+    done[i] = true;
+    if (linearize(next, ops, done, left - 1, capacity)) {
+      return true;
+    }
+    done[i] = false;
+  }
+  return false;
+}
+
+//          
+void testLinearizability(int threadCount, int opsPerThread, int capacity, int shardsPerPriority, int trials) {
+  std::mt19937 rng(7);
+  int failed = 0;
+  for (int trial = 0; trial < trials; ++trial) {
+    ConcurrentBuffer buffer(capacity, shardsPerPriority);
+    std::vector<std::vector<HistoryOp>> histories(threadCount);
+    for (int t = 0; t < threadCount; ++t) {
+      for (int k = 0; k < opsPerThread; ++k) {
+        //  ,  ,      
+        bool add = std::uniform_int_distribution<int>(0, 2)(rng) != 0;
+        Priority priority = static_cast<Priority>(std::uniform_int_distribution<int>(0, 2)(rng));
+        histories[t].push_back(HistoryOp{ add, t * opsPerThread + k + 1, priority, 0, 0, 0 });
+      }
+    }
+
+    std::atomic<long long> clock(0);
+    std::atomic<bool> start(false);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+      threads.emplace_back([&, t]() {
+        while (!start.load()) {
+        }
+        for (HistoryOp& op : histories[t]) {
+          op.invoked = clock.fetch_add(1);
+          Request req;
+          if (op.add) {
+            buffer.addRequest(Request(op.requestId, t + 1, 0, op.priority), req);
+            op.result = req.getRequestId();
+          }
+          else {
+            op.result = buffer.takeRequest(req) ? req.getRequestId() : 0;
+          }
+          op.responded = clock.fetch_add(1);
+        }
+      });
+    }
+    start = true;
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    std::vector<HistoryOp> ops;
+    for (const auto& history : histories) {
+      ops.insert(ops.end(), history.begin(), history.end());
+    }
+    std::vector<bool> done(ops.size(), false);
+    if (!linearize(SpecState(), ops, done, static_cast<int>(ops.size()), capacity)) {
+      ++failed;
+    }
+  }
+  expect(failed == 0, " ( " + std::to_string(threadCount) + ",  " + std::to_string(opsPerThread) +
+    ",  " + std::to_string(capacity) + "):   " + std::to_string(failed) + "  " + std::to_string(trials));
+}
+
+}
+
+int main() {
+  testSequentialContract();
+  testLinearizability(3, 4, 2, 2, 2000);
+  testLinearizability(4, 3, 3, 1, 2000);
+
+  int hw = std::max(2, static_cast<int>(std::thread::hardware_concurrency()));
+  //   -  ,  -   
+  testStress(1, 1, 16, 2, 20000);
+  testStress(5, 4, 16, 4, 20000);
+  testStress(5, 7, hw, hw, 20000);
+  testStress(64, 4, 16, 1, 20000);
+  //           
+  testStress(8, 4, 16, 0, 20000);
+
+  return testSummary("ConcurrentBuffer");
+}
@@ -0,0 +1,144 @@
+//     :  ,  ,  ,
+//   .
+//      Code:
+//   g++ -std=c++17 -O2 -I. Tests/DistributionTest.cpp Distribution.cpp -o distribution_test && ./distribution_test
+#include "Distribution.h"
+#include "TestUtil.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+bool near(double actual, double expected, double relativeTolerance) {
+  return std::fabs(actual - expected) <= relativeTolerance * std::fabs(expected);
+}
+
+//      sampleCount 
+void sampleMoments(const Distribution& distribution, int sampleCount, double& mean, double& variance) {
+  std::default_random_engine generator(12345);
+  double sum = 0.0;
+  double sumSq = 0.0;
+  for (int i = 0; i < sampleCount; ++i) {
+    double x = distribution.sample(generator);
+    sum += x;
+    sumSq += x * x;
+  }
+  mean = sum / sampleCount;
+  variance = (sumSq - sum * sum / sampleCount) / (sampleCount - 1);
+}
+
+void checkMoments(const std::string& name, const Distribution& distribution, double expectedMean, double expectedVariance) {
+  double mean;
+  double variance;
+  sampleMoments(distribution, 400000, mean, variance);
+  expect(near(distribution.getMean(), expectedMean, 1e-12), name + ": getMean() = " + std::to_string(distribution.getMean()));
+  expect(near(mean, expectedMean, 0.01), name + ":   " + std::to_string(mean) + ",  " + std::to_string(expectedMean));
+  expect(near(variance, expectedVariance, 0.05), name + ":   " + std::to_string(variance) + ",  " + std::to_string(expectedVariance));
+}
+
+void testMoments() {
+  checkMoments("", ExponentialDistribution(10.0), 10.0, 100.0);
+  checkMoments("", UniformDistribution(0.0, 20.0), 10.0, 400.0 / 12.0);
+  checkMoments("", ErlangDistribution(4, 10.0), 10.0, 100.0 / 4.0);
+  checkMoments("", LognormalDistribution(10.0, 5.0), 10.0, 25.0);
+  //  : std::lognormal_distribution  sigma = 0  ,  
+  LognormalDistribution constant(10.0, 0.0);
+  std::default_random_engine generator(1);
+  bool allMean = true;
+  for (int i = 0; i < 1000; ++i) {
+    allMean = allMean && constant.sample(generator) == 10.0;
+  }
+  expect(allMean && constant.getMean() == 10.0, "  :   ");
+  //  : E = sum p*m, E[X^2] = sum p*2m^2
+  checkMoments("", HyperexponentialDistribution({ 0.9, 0.1 }, { 5.0, 55.0 }), 10.0,
+    0.9 * 2 * 25.0 + 0.1 * 2 * 3025.0 - 100.0);
+  //    [0, 10)   1  [10, 30)   3
+  checkMoments("", EmpiricalDistribution({ 0.0, 10.0, 30.0 }, { 1.0, 3.0 }), 0.25 * 5.0 + 0.75 * 20.0,
+    0.25 * (100.0 / 3.0) + 0.75 * (400.0 / 12.0 + 400.0) - std::pow(0.25 * 5.0 + 0.75 * 20.0, 2));
+}
+
+void testAliasTable() {
+  const std::vector<double> weights = { 1.0, 2.0, 3.0, 4.0, 0.0 };
+  AliasTable table(weights);
+  expect(table.size() == 5, " :  ");
+
+  std::default_random_engine generator(777);
+  const int sampleCount = 1000000;
+  std::vector<int> counts(weights.size(), 0);
+  for (int i = 0; i < sampleCount; ++i) {
+    counts[table.sample(generator)]++;
+  }
+  for (size_t i = 0; i < weights.size(); ++i) {
+    double expected = weights[i] / 10.0;
+    double actual = static_cast<double>(counts[i]) / sampleCount;
+    expect(std::fabs(actual - expected) < 0.003, " :   " + std::to_string(i) + " = " + std::to_string(actual)
+      + ",  " + std::to_string(expected));
+  }
+  expect(counts[4] == 0, " :     ");
+
+  //          
+  EmpiricalDistribution empirical({ 0.0, 1.0, 2.0, 3.0 }, { 1.0, 0.0, 1.0 });
+  bool outside = false;
+  for (int i = 0; i < 100000; ++i) {
+    double x = empirical.sample(generator);
+    outside = outside || x < 0.0 || x > 3.0 || (x > 1.0 && x < 2.0);
+  }
+  expect(!outside, ":      ");
+}
+
+void testInvalidParameters() {
+  expectThrows<std::invalid_argument>("   ", []() { AliasTable table(std::vector<double>{}); });
+  expectThrows<std::invalid_argument>("    ", []() { AliasTable table({ 1.0, -1.0 }); });
+  expectThrows<std::invalid_argument>("    ", []() { AliasTable table({ 0.0, 0.0 }); });
+  expectThrows<std::invalid_argument>("   0", []() { ExponentialDistribution d(0.0); });
+  expectThrows<std::invalid_argument>("  b < a", []() { UniformDistribution d(2.0, 1.0); });
+  expectThrows<std::invalid_argument>("  0", []() { ErlangDistribution d(0, 10.0); });
+  expectThrows<std::invalid_argument>("   ", []() { LognormalDistribution d(10.0, -1.0); });
+  expectThrows<std::invalid_argument>("    ", []() { HyperexponentialDistribution d({ 0.5, 0.5 }, { 1.0 }); });
+  expectThrows<std::invalid_argument>("    ", []() { HyperexponentialDistribution d({ 0.5, 0.5 }, { 1.0, 0.0 }); });
+  expectThrows<std::invalid_argument>("   ", []() { EmpiricalDistribution d({ 0.0, 1.0, 2.0 }, { 1.0 }); });
+  expectThrows<std::invalid_argument>("   ", []() { EmpiricalDistribution d({ 0.0, 2.0, 1.0 }, { 1.0, 1.0 }); });
+  expectThrows<std::invalid_argument>("    ", []() { EmpiricalDistribution d({ 0.0, 1.0, 1.0 }, { 1.0, 1.0 }); });
+  expectThrows<std::invalid_argument>("   ", []() { EmpiricalDistribution d({ -1.0, 1.0 }, { 1.0 }); });
+}
+
+//     (      ),
+//        
+void testOwnedCopies() {
+  LognormalDistribution prototype(10.0, 5.0);
+  OwnedDistribution original(prototype);
+  OwnedDistribution copy(original);
+
+  std::default_random_engine reference(42);
+  std::default_random_engine first(42);
+  std::default_random_engine second(42);
+  OwnedDistribution alone(prototype);
+  bool identical = true;
+  for (int i = 0; i < 1000; ++i) {
+    //      ;      
+    double expected = alone->sample(reference);
+    double a = original->sample(first);
+    double b = copy->sample(second);
+    identical = identical && a == expected && b == expected;
+  }
+  expect(identical, "    ");
+
+  OwnedDistribution assigned;
+  expect(!assigned, " ");
+  assigned = original;
+  expect(static_cast<bool>(assigned) && assigned->getMean() == prototype.getMean(), "  ");
+}
+
+}
+
+int main() {
+  testMoments();
+  testAliasTable();
+  testInvalidParameters();
+  testOwnedCopies();
+
+  return testSummary("Distribution");
+}
@@ -0,0 +1,141 @@
+//   :      ,   ,
+//  ,       .
+//      Code:
+//   g++ -std=c++17 -O2 -pthread -I. Tests/EventCalendarTest.cpp $(ls *.cpp | grep -v main.cpp) -o event_calendar_test && ./event_calendar_test
+#include "EventCalendar.h"
+#include "TestUtil.h"
+#include <random>
+#include <vector>
+#include <string>
+
+namespace {
+
+Event makeEvent(double time, int requestId) {
+  return Event(toSimTime(time), EventType::SCALING_CHECK, -1, requestId);
+}
+
+//  :     ,   -   
+struct Expected {
+  int requestId;
+  SimTime time;
+  unsigned long long order;
+  EventHandle handle;
+};
+
+size_t findMin(const std::vector<Expected>& live) {
+  size_t best = 0;
+  for (size_t i = 1; i < live.size(); ++i) {
+    if (live[i].time < live[best].time || (live[i].time == live[best].time && live[i].order < live[best].order)) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+void testRandomMix() {
+  std::mt19937 rng(2024);
+  EventCalendar calendar;
+  std::vector<Expected> live;
+  std::vector<EventHandle> stale;
+  unsigned long long order = 0;
+  int nextId = 1;
+  bool consistent = true;
+  bool matches = true;
+
+  for (int step = 0; step < 20000; ++step) {
+    int op = std::uniform_int_distribution<int>(0, 9)(rng);
+    //           
+    double time = std::uniform_int_distribution<int>(0, 50)(rng);
+    if (op < 4 || live.empty()) {
+      Expected e{ nextId, toSimTime(time), order++, EventHandle() };
+      e.handle = calendar.push(makeEvent(time, nextId++));
+      live.push_back(e);
+    }
+    else if (op < 6) {
+      size_t i = std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng);
+      matches = matches && calendar.cancel(live[i].handle);
+      stale.push_back(live[i].handle);
+      live.erase(live.begin() + i);
+    }
+    else if (op < 8) {
+      size_t i = std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng);
+      matches = matches && calendar.reschedule(live[i].handle, toSimTime(time));
+      live[i].time = toSimTime(time);
+      live[i].order = order++;
+    }
+    else {
+      size_t i = findMin(live);
+      matches = matches && calendar.top().requestId == live[i].requestId;
+      stale.push_back(live[i].handle);
+      calendar.pop();
+      live.erase(live.begin() + i);
+    }
+    consistent = consistent && calendar.isConsistent() && calendar.size() == live.size();
+  }
+  expect(consistent, "        ");
+  expect(matches, "    (,  )");
+
+  //     ,   
+  size_t before = calendar.size();
+  bool staleRejected = true;
+  for (const EventHandle& h : stale) {
+    staleRejected = staleRejected && !calendar.contains(h) && !calendar.cancel(h) && !calendar.reschedule(h, toSimTime(0.0));
+  }
+  expect(staleRejected && calendar.size() == before && calendar.isConsistent(), "  ");
+
+  bool drained = true;
+  while (!live.empty()) {
+    size_t i = findMin(live);
+    drained = drained && calendar.top().requestId == live[i].requestId;
+    calendar.pop();
+    live.erase(live.begin() + i);
+  }
+  expect(drained && calendar.empty(), "     ");
+}
+
+void testStaleHandle() {
+  EventCalendar calendar;
+  EventHandle first = calendar.push(makeEvent(1.0, 1));
+  expect(calendar.cancel(first), "  ");
+  expect(!calendar.cancel(first), " ");
+
+  //     ,     
+  EventHandle second = calendar.push(makeEvent(2.0, 2));
+  expect(second.slot == first.slot && second.generation != first.generation, "    ");
+  expect(!calendar.contains(first) && !calendar.reschedule(first, toSimTime(0.5)), "    ");
+  expect(calendar.contains(second) && calendar.top().requestId == 2 && calendar.top().time == toSimTime(2.0),
+    "     ");
+
+  calendar.pop();
+  expect(!calendar.contains(second) && !calendar.cancel(second), "  ");
+}
+
+void testSameTimeOrder() {
+  EventCalendar calendar;
+  std::vector<EventHandle> handles;
+  for (int id = 1; id <= 5; ++id) {
+    handles.push_back(calendar.push(makeEvent(3.0, id)));
+  }
+  calendar.push(makeEvent(1.0, 6));
+  //          
+  calendar.reschedule(handles[1], toSimTime(3.0));
+  //      -   ,    
+  EventHandle late = calendar.push(makeEvent(9.0, 7));
+  calendar.reschedule(late, toSimTime(3.0));
+
+  std::vector<int> order;
+  while (!calendar.empty()) {
+    order.push_back(calendar.top().requestId);
+    calendar.pop();
+  }
+  expect(order == std::vector<int>({ 6, 1, 3, 4, 5, 2, 7 }), "       ");
+}
+
+}
+
+int main() {
+  testRandomMix();
+  testStaleHandle();
+  testSameTimeOrder();
+  return testSummary("EventCalendar");
+}
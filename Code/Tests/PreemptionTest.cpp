@@ -0,0 +1,109 @@
+//   :          
+//    (D1004)    ,   .
+//      Code:
+//   g++ -std=c++17 -O2 -pthread -I. Tests/PreemptionTest.cpp $(ls *.cpp | grep -v main.cpp) -o preemption_test && ./preemption_test
+#include "SimulationController.h"
+#include "TestUtil.h"
+#include <fstream>
+#include <cstdio>
+#include <string>
+
+namespace {
+
+Request makeRequest(int id, int sourceId, double enteredBuffer, Priority priority) {
+  Request req(id, sourceId, toSimTime(enteredBuffer), priority);
+  req.setTimeEnteredBuffer(toSimTime(enteredBuffer));
+  return req;
+}
+
+bool contains(const Buffer& buffer, int requestId) {
+  for (int i = 0; i < buffer.getCapacity(); ++i) {
+    if (buffer.getOccupancy()[i] && buffer.getSlots()[i].getRequestId() == requestId) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void testBufferReinsert() {
+  Buffer buffer(2);
+  Request replaced;
+  buffer.addRequest(makeRequest(2, 2, 0.5, Priority::PRIVATE), replaced);
+  buffer.addRequest(makeRequest(3, 1, 1.0, Priority::WARRANTY), replaced);
+  //         #1 (    0)
+  buffer.markSlotFree(buffer.selectSlot());
+  int ringPointer = buffer.getRingPointer();
+
+  Request none;
+  expect(buffer.reinsert(makeRequest(1, 3, 0.0, Priority::PRIVATE), none), "  ");
+  expect(none.getRequestId() == 0, "      ");
+  expect(buffer.getRingPointer() == ringPointer, "    ");
+
+  // :   #2,   
+  buffer.addRequest(makeRequest(4, 2, 2.0, Priority::PRIVATE), replaced);
+  expect(replaced.getRequestId() == 2, "D1004  :  #" + std::to_string(replaced.getRequestId()) + ",  #2");
+  expect(contains(buffer, 1) && contains(buffer, 4), "      ");
+
+  //         
+  Request evicted;
+  Buffer full(2);
+  full.addRequest(makeRequest(5, 2, 3.0, Priority::PRIVATE), replaced);
+  full.addRequest(makeRequest(6, 2, 4.0, Priority::PRIVATE), replaced);
+  expect(full.reinsert(makeRequest(7, 3, 1.0, Priority::PRIVATE), evicted) && evicted.getRequestId() == 6
+    && evicted.getStatus() == RequestStatus::REJECTED, "      ");
+  full.addRequest(makeRequest(8, 2, 5.0, Priority::PRIVATE), replaced);
+  expect(replaced.getRequestId() == 5, "D1004  ,   ");
+  expect(contains(full, 7), "    ");
+}
+
+//  ,   2 ,  (RESUME):
+//   0.0 -   3 ( 10)  ;
+//   0.5 -   2   ;
+//   1.0 -   1   3,    ;
+//   2.0 -   2  :   0.5,   .
+//   :  1 ( 6.0)   2.0 ( 7.0) -  9 ,  16.0
+void testPreemptThenOverflow() {
+  const std::string path = "preemption_test_trace.csv";
+  {
+    std::ofstream trace(path);
+    trace << "time,source,priority,service\n"
+      << "0.0,3,0,10\n"
+      << "0.5,2,0,1\n"
+      << "1.0,1,2,5\n"
+      << "2.0,2,0,1\n";
+  }
+
+  SimulationConfig config;
+  config.deviceCount = 1;
+  config.bufferSize = 2;
+  config.preemption = PreemptionMode::RESUME;
+  config.seed = 1;
+  SimulationController controller(config);
+  controller.loadTrace({ path });
+  controller.runToCompletion();
+  std::remove(path.c_str());
+
+  SimulationResults results = controller.getResults();
+  const SourceResults* interrupted = nullptr;
+  const SourceResults* later = nullptr;
+  for (const SourceResults& s : results.sources) {
+    if (s.sourceId == 3) interrupted = &s;
+    if (s.sourceId == 2) later = &s;
+  }
+  expect(interrupted && later && results.preemptions == 1, "  ");
+  if (!interrupted || !later) {
+    return;
+  }
+  expect(interrupted->rejected == 0 && interrupted->completed == 1, "  ,   ");
+  expect(later->rejected == 1 && later->completed == 1, " ,   ");
+  expectNear(interrupted->meanProcessing, 10.0, 1e-9, "   ");
+  expectNear(interrupted->meanTimeInSystem, 16.0, 1e-9, "   ");
+}
+
+}
+
+int main() {
+  testBufferReinsert();
+  testPreemptThenOverflow();
+  return testSummary("Preemption");
+}
@@ -0,0 +1,81 @@
+//    :         .
+//      Code:
+//   g++ -std=c++17 -O2 -pthread -I. Tests/RealTimeControllerTest.cpp $(ls *.cpp | grep -v main.cpp) -o real_time_test && ./real_time_test
+#include "RealTimeController.h"
+#include "TestUtil.h"
+#include <vector>
+#include <string>
+
+namespace {
+
+// ,     ,     .
+//     :       
+void testMergeMatchesSingleThread() {
+  std::vector<double> waits;
+  for (int i = 0; i < 1000; ++i) {
+    waits.push_back(1.0 + 1e-6 * (i % 7));
+  }
+  RealTimeSourceStats single;
+  RealTimeSourceStats first;
+  RealTimeSourceStats second;
+  for (size_t i = 0; i < waits.size(); ++i) {
+    single.addCompleted(waits[i] + 1e-6, waits[i], 1e-6 * (i % 3));
+    (i < 300 ? first : second).addCompleted(waits[i] + 1e-6, waits[i], 1e-6 * (i % 3));
+  }
+  first.merge(second);
+
+  double mean = 0.0;
+  for (double w : waits) mean += w;
+  mean /= waits.size();
+  double sumSq = 0.0;
+  for (double w : waits) sumSq += (w - mean) * (w - mean);
+  double variance = sumSq / (waits.size() - 1);
+
+  expect(first.completed == 1000, "  ");
+  expectNear(single.waitingVariance(), variance, variance * 1e-6, "  ");
+  expectNear(first.waitingVariance(), variance, variance * 1e-6, "  ");
+  expectNear(first.meanWaiting, mean, 1e-12, "T  ");
+  expectNear(first.processingVariance(), single.processingVariance(), 1e-18, "  ");
+
+  //       
+  RealTimeSourceStats empty;
+  empty.merge(first);
+  expectNear(empty.waitingVariance(), first.waitingVariance(), 1e-18, "   ");
+}
+
+//  :    ,  ,    
+void testSmokeRun() {
+  RealTimeConfig config;
+  config.producerCount = 1;
+  config.deviceCount = 2;
+  config.bufferSize = 5;
+  config.durationSeconds = 0.2;
+  config.meanServiceMicros = 5.0;
+  RealTimeController controller(config);
+  controller.run();
+
+  long long generated = 0;
+  long long rejected = 0;
+  long long completed = 0;
+  bool sane = true;
+  std::vector<RealTimeSourceStats> stats = controller.getSourceStats();
+  for (size_t i = 1; i < stats.size(); ++i) {
+    generated += stats[i].generated;
+    rejected += stats[i].rejected;
+    completed += stats[i].completed;
+    sane = sane && stats[i].meanWaiting >= 0.0 && stats[i].waitingVariance() >= 0.0 && stats[i].processingVariance() >= 0.0;
+  }
+  expect(generated > 0 && completed > 0, "   ");
+  expect(generated == completed + rejected, " " + std::to_string(generated) + ",  " + std::to_string(completed) +
+    ",  " + std::to_string(rejected));
+  expect(sane, "   ");
+  expect(controller.getElapsedSeconds() >= config.durationSeconds, " ");
+}
+
+}
+
+int main() {
+  testMergeMatchesSingleThread();
+  testSmokeRun();
+  return testSummary("RealTimeController");
+}
@@ -0,0 +1,167 @@
+//    :    (, ,  ),
+//   ,      ,  
+//  ,  .
+//      Code:
+//   g++ -std=c++17 -O2 -pthread -I. Tests/ScalingTest.cpp $(ls *.cpp | grep -v main.cpp) -o scaling_test && ./scaling_test
+#include "SimulationController.h"
+#include "TestUtil.h"
+#include <fstream>
+#include <cstdio>
+#include <string>
+
+namespace {
+
+const char* TRACE_PATH = "scaling_test_trace.csv";
+
+ScalingObservation observe(double time, double occupancy, double rejection, int online, int starting) {
+  ScalingObservation observation;
+  observation.time = time;
+  observation.meanOccupancy = occupancy;
+  observation.rejectionRate = rejection;
+  observation.onlineDevices = online;
+  observation.startingDevices = starting;
+  return observation;
+}
+
+void testDecide() {
+  ScalingPolicy policy;
+  policy.enabled = true;
+  policy.minDevices = 1;
+  policy.maxDevices = 3;
+  policy.cooldown = 20.0;
+  //   :    >= 0.6   >= 0.05,   <= 0.1  <= 0.01
+
+  expect(policy.decide(observe(100.0, 0.9, 0.0, 2, 0), 90.0) == ScalingAction::NONE, "     ");
+  expect(policy.decide(observe(110.0, 0.9, 0.0, 2, 0), 90.0) == ScalingAction::SCALE_UP, "    ");
+  expect(policy.decide(observe(110.0, 0.0, 0.05, 2, 0), 90.0) == ScalingAction::SCALE_UP, "  ");
+  expect(policy.decide(observe(110.0, 0.9, 0.0, 2, 1), 90.0) == ScalingAction::NONE, "     ");
+  expect(policy.decide(observe(110.0, 0.9, 0.0, 3, 0), 90.0) == ScalingAction::NONE, "   ");
+
+  //   ()       
+  expect(policy.decide(observe(110.0, 0.3, 0.0, 2, 0), 90.0) == ScalingAction::NONE, "  ");
+  expect(policy.decide(observe(110.0, 0.05, 0.03, 2, 0), 90.0) == ScalingAction::NONE, "  ");
+
+  expect(policy.decide(observe(110.0, 0.05, 0.0, 2, 0), 90.0) == ScalingAction::SCALE_DOWN, "");
+  expect(policy.decide(observe(100.0, 0.05, 0.0, 2, 0), 90.0) == ScalingAction::NONE, "   ");
+  expect(policy.decide(observe(110.0, 0.05, 0.0, 2, 1), 90.0) == ScalingAction::NONE, ",    ");
+  expect(policy.decide(observe(110.0, 0.05, 0.0, 1, 0), 90.0) == ScalingAction::NONE, "  ");
+
+  ScalingPolicy overlapping = policy;
+  overlapping.scaleDownOccupancy = overlapping.scaleUpOccupancy;
+  expectThrows<std::invalid_argument>("     ", [&]() { overlapping.validate(); });
+  ScalingPolicy bounds = policy;
+  bounds.maxDevices = 0;
+  expectThrows<std::invalid_argument>("maxDevices < minDevices", [&]() { bounds.validate(); });
+}
+
+const SourceResults* findSource(const SimulationResults& results, int sourceId) {
+  for (const SourceResults& s : results.sources) {
+    if (s.sourceId == sourceId) {
+      return &s;
+    }
+  }
+  return nullptr;
+}
+
+//  ,      20.     5   - 
+//  ,          ,   20:
+//   6.0  -  2    (  )  20,    ;
+//   20.5 -  3 ,       21.
+//      20       -  1,   20/40
+void testRetiringBusyDevice() {
+  {
+    std::ofstream trace(TRACE_PATH);
+    trace << "time,source,priority,service\n"
+      << "0.0,1,0,20\n"
+      << "0.0,1,0,20\n"
+      << "6.0,2,0,1\n"
+      << "20.5,3,0,1\n";
+  }
+
+  SimulationConfig config;
+  config.deviceCount = 2;
+  config.bufferSize = 5;
+  config.simulationEndTime = 40.0;
+  config.seed = 1;
+  config.scaling.enabled = true;
+  config.scaling.minDevices = 1;
+  config.scaling.maxDevices = 2;
+  config.scaling.evaluationInterval = 5.0;
+  config.scaling.cooldown = 0.0;
+  SimulationController controller(config);
+  controller.loadTrace({ TRACE_PATH });
+  controller.runToCompletion();
+  std::remove(TRACE_PATH);
+
+  SimulationResults results = controller.getResults();
+  expect(results.scaleDowns == 1 && results.scaleUps == 0, "  ,  " + std::to_string(results.scaleDowns));
+  expect(results.deviceUtilization.size() == 2, "   ");
+  if (results.deviceUtilization.size() == 2) {
+    expectNear(results.deviceUtilization[1], 1.0, 1e-9, " :     ");
+    expectNear(results.deviceUtilization[0], 22.0 / 40.0, 1e-9, " : ");
+  }
+  expectNear(results.meanOnlineDevices, 60.0 / 40.0, 1e-9, "    ");
+
+  const SourceResults* waiting = findSource(results, 2);
+  const SourceResults* late = findSource(results, 3);
+  expect(waiting && late && waiting->completed == 1 && late->completed == 1, "   ");
+  if (waiting && late) {
+    expectNear(waiting->meanWaiting, 14.0, 1e-9, "     ");
+    expectNear(late->meanWaiting, 0.5, 1e-9, "     ");
+  }
+}
+
+//   1     100   2,    .
+//  ,   ,     2
+double meanProcessingWithOverride(bool byPriority, Priority priority) {
+  SimulationConfig config;
+  config.deviceCount = 1;
+  config.bufferSize = 2;
+  config.simulationEndTime = 400.0;
+  config.seed = 1;
+  config.serviceDistribution = std::make_shared<LognormalDistribution>(1.0, 0.0);
+  config.sources.clear();
+  config.sources.emplace_back(0.5, priority);
+  config.scaling.enabled = true;
+  config.scaling.minDevices = 1;
+  config.scaling.maxDevices = 2;
+  config.scaling.evaluationInterval = 5.0;
+  config.scaling.startupDelay = 0.0;
+  config.scaling.cooldown = 0.0;
+  SimulationController controller(config);
+  std::shared_ptr<const Distribution> slow = std::make_shared<LognormalDistribution>(100.0, 0.0);
+  if (byPriority) {
+    controller.setDeviceServiceDistribution(2, priority, slow);
+  }
+  else {
+    controller.setDeviceServiceDistribution(2, slow);
+  }
+  controller.runToCompletion();
+
+  SimulationResults results = controller.getResults();
+  expect(results.scaleUps >= 1, "  ");
+  return results.sources.empty() ? 0.0 : results.sources[0].meanProcessing;
+}
+
+void testOverrideForScaledDevice() {
+  expect(meanProcessingWithOverride(false, Priority::PRIVATE) > 1.5, "  2   ");
+  expect(meanProcessingWithOverride(true, Priority::WARRANTY) > 1.5, "  2     ");
+
+  SimulationConfig config;
+  config.deviceCount = 1;
+  config.scaling.enabled = true;
+  config.scaling.maxDevices = 2;
+  SimulationController controller(config);
+  std::shared_ptr<const Distribution> slow = std::make_shared<LognormalDistribution>(100.0, 0.0);
+  expectThrows<std::out_of_range>("ID   maxDevices", [&]() { controller.setDeviceServiceDistribution(3, slow); });
+  expectThrows<std::out_of_range>("ID  0", [&]() { controller.setDeviceServiceDistribution(0, Priority::PRIVATE, slow); });
+}
+
+}
+
+int main() {
+  testDecide();
+  testRetiringBusyDevice();
+  testOverrideForScaledDevice();
+  return testSummary("Scaling");
+}
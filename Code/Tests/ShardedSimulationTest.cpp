@@ -0,0 +1,109 @@
+//   :          ,
+//      .
+//      Code:
+//   g++ -std=c++17 -O2 -pthread -I. Tests/ShardedSimulationTest.cpp $(ls *.cpp | grep -v main.cpp) -o sharded_test && ./sharded_test
+#include "ShardedSimulation.h"
+#include "TestUtil.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+void expectSameResults(const SimulationResults& sharded, const SimulationResults& single, const std::string& name) {
+  expect(sharded.sources.size() == single.sources.size(), name + ":  ");
+  for (size_t i = 0; i < sharded.sources.size() && i < single.sources.size(); ++i) {
+    const SourceResults& a = sharded.sources[i];
+    const SourceResults& b = single.sources[i];
+    std::string source = name + ", " + std::to_string(a.sourceId);
+    expect(a.generated == b.generated && a.rejected == b.rejected && a.completed == b.completed, source + ":  ");
+    expect(a.meanWaiting == b.meanWaiting && a.waitingVariance == b.waitingVariance && a.meanProcessing == b.meanProcessing,
+      source + ": T   T ");
+    expect(a.p99Waiting == b.p99Waiting && a.deadlineMissRate == b.deadlineMissRate, source + ": p99   ");
+  }
+  expect(sharded.deviceUtilization == single.deviceUtilization && sharded.meanOnlineDevices == single.meanOnlineDevices,
+    name + ":  ");
+  expect(sharded.preemptions == single.preemptions, name + ": ");
+  expect(sharded.scaleUps == single.scaleUps && sharded.scaleDowns == single.scaleDowns, name + ":  ");
+}
+
+//  -  SimulationController   ,     
+//        
+void testSingleShardEquivalence() {
+  for (int variant = 0; variant < 4; ++variant) {
+    SimulationConfig config;
+    config.seed = 99;
+    config.simulationEndTime = 20000.0;
+    if (variant >= 1) {
+      config.preemption = PreemptionMode::RESUME;
+    }
+    if (variant >= 2) {
+      config.serviceDistribution = std::make_shared<LognormalDistribution>(10.0, 6.0);
+      config.selection.discipline = SelectionDiscipline::EDF;
+    }
+    if (variant >= 3) {
+      config.scaling.enabled = true;
+      config.scaling.minDevices = 2;
+      config.scaling.maxDevices = 6;
+      config.sources[0].intervalDistribution = std::make_shared<ErlangDistribution>(2, 10.0);
+    }
+
+    SimulationController single(config);
+    single.runToCompletion();
+
+    ShardedConfig shardedConfig;
+    shardedConfig.shardCount = 1;
+    shardedConfig.shard = config;
+    shardedConfig.policy = RoutingPolicy::ROUND_ROBIN;
+    ShardedSimulation sharded(shardedConfig);
+    sharded.runToCompletion();
+
+    expectSameResults(sharded.getShardResults(0), single.getResults(), " " + std::to_string(variant));
+  }
+}
+
+void testRoundRobin() {
+  ShardedConfig config;
+  config.shardCount = 5;
+  config.shard.seed = 7;
+  config.shard.simulationEndTime = 5000.0;
+  config.policy = RoutingPolicy::ROUND_ROBIN;
+  ShardedSimulation sharded(config);
+  sharded.runToCompletion();
+
+  std::vector<int> generated;
+  for (int k = 0; k < sharded.getShardCount(); ++k) {
+    SimulationResults results = sharded.getShardResults(k);
+    int total = 0;
+    for (const SourceResults& s : results.sources) {
+      total += s.generated;
+      expect(s.rejected + s.completed <= s.generated, " " + std::to_string(k + 1) + ":   ,  ");
+    }
+    generated.push_back(total);
+  }
+  for (int k = 1; k < sharded.getShardCount(); ++k) {
+    int difference = generated[k - 1] - generated[k];
+    expect(difference == 0 || difference == 1, " :  " + std::to_string(k) + "  " + std::to_string(k + 1)
+      + "  " + std::to_string(generated[k - 1]) + "  " + std::to_string(generated[k]));
+  }
+}
+
+void testInvalidConfig() {
+  expectThrows<std::invalid_argument>("  ", []() {
+    ShardedConfig config;
+    config.shardCount = 0;
+    ShardedSimulation sharded(config);
+  });
+}
+
+}
+
+int main() {
+  testSingleShardEquivalence();
+  testRoundRobin();
+  testInvalidConfig();
+
+  return testSummary("ShardedSimulation");
+}
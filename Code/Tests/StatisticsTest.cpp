@@ -0,0 +1,78 @@
+//   :     ,   P^2.
+//      Code:
+//   g++ -std=c++17 -O2 -I. Tests/StatisticsTest.cpp Statistics.cpp -o statistics_test && ./statistics_test
+#include "Statistics.h"
+#include "TestUtil.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <random>
+#include <algorithm>
+
+namespace {
+
+void testQuantiles() {
+  expectNear(normalQuantile(0.975), 1.959964, 1e-6, "z 0.975");
+  expectNear(normalQuantile(0.5), 0.0, 1e-9, "z 0.5");
+  expectNear(normalQuantile(1e-6), -4.753424, 1e-6, "z 1e-6");
+
+  //   t   
+  expectNear(studentQuantile(1), 12.7062, 1e-3, "t(1; 0.05)");
+  expectNear(studentQuantile(2), 4.3027, 1e-3, "t(2; 0.05)");
+  expectNear(studentQuantile(5), 2.5706, 1e-3, "t(5; 0.05)");
+  expectNear(studentQuantile(29), 2.0452, 1e-3, "t(29; 0.05)");
+  expectNear(studentQuantile(3, 0.001), 12.924, 1e-2, "t(3; 0.001)");
+  expectNear(studentQuantile(10, 0.001), 4.587, 1e-2, "t(10; 0.001)");
+  expectNear(studentQuantile(1000), 1.9623, 1e-3, "t(1000; 0.05)");
+  //        -    
+  expect(studentQuantile(29, 1e-5) > studentQuantile(29, 1e-4) && studentQuantile(29, 1e-4) > studentQuantile(29, 1e-3),
+    "t     ");
+
+  std::vector<double> values = { 1.0, 2.0, 3.0, 4.0 };
+  expectNear(sampleMean(values), 2.5, 1e-12, "");
+  expectNear(confidenceHalfWidth(values), 3.1824 * std::sqrt(5.0 / 3.0 / 4.0), 1e-3, " ");
+  expectNear(confidenceHalfWidth({ 1.0 }), 0.0, 0.0, "   ");
+}
+
+void testP2Quantile() {
+  //      ( ceil(q * n))
+  P2Quantile small(0.5);
+  expectNear(small.getValue(), 0.0, 0.0, "P2  ");
+  for (double x : { 5.0, 1.0, 3.0 }) {
+    small.add(x);
+  }
+  expectNear(small.getValue(), 3.0, 0.0, "P2  ");
+
+  //         
+  std::default_random_engine generator(2024);
+  std::exponential_distribution<double> exponential(0.1);
+  std::lognormal_distribution<double> lognormal(1.0, 0.8);
+  for (int kind = 0; kind < 2; ++kind) {
+    P2Quantile p99(0.99);
+    P2Quantile median(0.5);
+    std::vector<double> values;
+    for (int i = 0; i < 200000; ++i) {
+      double x = (kind == 0) ? exponential(generator) : lognormal(generator);
+      p99.add(x);
+      median.add(x);
+      values.push_back(x);
+    }
+    std::sort(values.begin(), values.end());
+    double exact99 = values[static_cast<size_t>(std::ceil(0.99 * values.size())) - 1];
+    double exact50 = values[values.size() / 2 - 1];
+    std::string name = (kind == 0) ? "P2 " : "P2 ";
+    expectNear(p99.getValue(), exact99, 0.02 * exact99, name + " 99%");
+    expectNear(median.getValue(), exact50, 0.02 * exact50, name + " 50%");
+    expect(p99.getCount() == 200000, name + ":  ");
+  }
+}
+
+}
+
+int main() {
+  testQuantiles();
+  testP2Quantile();
+
+  return testSummary("Statistics");
+}
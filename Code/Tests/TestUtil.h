@@ -0,0 +1,47 @@
+#ifndef TESTUTIL_H
+#define TESTUTIL_H
+
+//    .      
+// return testSummary("<>"):  0 -   , 1 -  
+#include <iostream>
+#include <string>
+#include <cmath>
+#include <functional>
+
+inline int testFailures = 0;
+
+inline void expect(bool condition, const std::string& message) {
+  if (!condition) {
+    std::cout << ": " << message << std::endl;
+    ++testFailures;
+  }
+}
+
+//    
+inline void expectNear(double actual, double expected, double tolerance, const std::string& name) {
+  expect(std::fabs(actual - expected) <= tolerance, name + ": " + std::to_string(actual) + ",  " + std::to_string(expected));
+}
+
+// ,      Exception
+template <typename Exception>
+void expectThrows(const std::string& name, const std::function<void()>& action) {
+  bool thrown = false;
+  try {
+    action();
+  }
+  catch (const Exception&) {
+    thrown = true;
+  }
+  expect(thrown, name + ":  ");
+}
+
+inline int testSummary(const std::string& suite) {
+  if (testFailures == 0) {
+    std::cout << suite << ":   " << std::endl;
+    return 0;
+  }
+  std::cout << suite << ":  " << testFailures << std::endl;
+  return 1;
+}
+
+#endif
@@ -0,0 +1,160 @@
+//   :  CSV   ,   ,
+//      ,      .
+//      Code:
+//   g++ -std=c++17 -O2 -pthread -I. Tests/TraceSourceTest.cpp $(ls *.cpp | grep -v main.cpp) -o trace_source_test && ./trace_source_test
+#include "TraceSource.h"
+#include "SimulationController.h"
+#include "TestUtil.h"
+#include <fstream>
+#include <cstdio>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string writeCsv(const std::string& name, const std::string& content) {
+  std::ofstream out(name, std::ios::binary);
+  out << content;
+  return name;
+}
+
+struct BinaryRecord {
+  double time;
+  int32_t sourceId;
+  int32_t priority;
+  double serviceTime;
+};
+
+std::string writeBinary(const std::string& name, const std::vector<BinaryRecord>& records) {
+  std::ofstream out(name, std::ios::binary);
+  out.write("SCTRACE1", 8);
+  for (const BinaryRecord& r : records) {
+    out.write(reinterpret_cast<const char*>(&r.time), sizeof(double));
+    out.write(reinterpret_cast<const char*>(&r.sourceId), sizeof(int32_t));
+    out.write(reinterpret_cast<const char*>(&r.priority), sizeof(int32_t));
+    out.write(reinterpret_cast<const char*>(&r.serviceTime), sizeof(double));
+  }
+  return name;
+}
+
+//   ;   
+std::vector<TraceRecord> readAll(const std::string& path) {
+  TraceReader reader(path);
+  std::vector<TraceRecord> records;
+  TraceRecord record;
+  while (reader.next(record)) {
+    records.push_back(record);
+  }
+  return records;
+}
+
+void expectRejected(const std::string& name, const std::string& content) {
+  std::string path = writeCsv("trace_source_test_bad.csv", content);
+  expectThrows<std::runtime_error>(name, [&]() { readAll(path); });
+  std::remove(path.c_str());
+}
+
+void testCsvParsing() {
+  std::string path = writeCsv("trace_source_test.csv",
+    "time,source,priority,service\r\n"
+    "# \r\n"
+    "\r\n"
+    "0.5,1,2\r\n"
+    " 1.0 , 2 , 1 , 3.5 \r\n"
+    "1.0,3,0,\n"
+    "2.25,2,1,4");
+  std::vector<TraceRecord> records = readAll(path);
+  std::remove(path.c_str());
+
+  expect(records.size() == 4, "CSV:  " + std::to_string(records.size()) + ",  4");
+  if (records.size() == 4) {
+    expect(records[0].time == 0.5 && records[0].sourceId == 1 && records[0].priority == Priority::WARRANTY && records[0].serviceTime < 0.0,
+      "CSV:    ");
+    expect(records[1].time == 1.0 && records[1].sourceId == 2 && records[1].priority == Priority::CORPORATE && records[1].serviceTime == 3.5,
+      "CSV:     '\\r'");
+    expect(records[2].sourceId == 3 && records[2].serviceTime < 0.0, "CSV:   ");
+    expect(records[3].time == 2.25 && records[3].serviceTime == 4.0, "CSV:     ");
+  }
+
+  expectRejected("CSV:    ", "1.0,2,1xyz\n");
+  expectRejected("CSV:    ", "1.0,2x,1\n");
+  expectRejected("CSV:     ", "1.0,2,1,5abc\n");
+  expectRejected("CSV:  ", "1.0,2,1,5,6\n");
+  expectRejected("CSV:  ", "1.0,2,3\n");
+  expectRejected("CSV:  ", "-1.0,2,1\n");
+  expectRejected("CSV: NaN  ", "-nan,2,1\n");
+  expectRejected("CSV:   ", "2.0,1,0\n1.0,1,0\n");
+}
+
+void testBinaryParsing() {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  std::string path = writeBinary("trace_source_test.bin", { { 0.0, 1, 2, 1.5 }, { 3.0, 4, 0, -1.0 } });
+  std::vector<TraceRecord> records = readAll(path);
+  expect(records.size() == 2 && records[0].serviceTime == 1.5 && records[1].sourceId == 4 && records[1].priority == Priority::PRIVATE
+    && records[1].serviceTime < 0.0, " :  ");
+
+  writeBinary(path, { { 1.0, 1, 0, -1.0 }, { nan, 1, 0, -1.0 } });
+  expectThrows<std::runtime_error>(" : NaN  ", [&]() { readAll(path); });
+  writeBinary(path, { { -2.0, 1, 0, -1.0 } });
+  expectThrows<std::runtime_error>(" :  ", [&]() { readAll(path); });
+  writeBinary(path, { { 1.0, 1, 0, nan } });
+  expectThrows<std::runtime_error>(" : NaN   ", [&]() { readAll(path); });
+  writeBinary(path, { { 1.0, 1, 5, -1.0 } });
+  expectThrows<std::runtime_error>(" :  ", [&]() { readAll(path); });
+  std::remove(path.c_str());
+}
+
+//      ,      ,  
+void testMerge() {
+  std::string first = writeCsv("trace_source_test_a.csv", "1.0,1,0\n3.0,1,0\n3.0,1,1\n");
+  std::string second = writeBinary("trace_source_test_b.bin", { { 0.5, 2, 0, -1.0 }, { 3.0, 2, 0, -1.0 }, { 4.0, 2, 0, -1.0 } });
+  std::string third = writeCsv("trace_source_test_c.csv", "");
+
+  TraceSource source({ first, second, third });
+  std::vector<std::pair<double, int>> merged;
+  double peeked = -1.0;
+  bool peekMatches = true;
+  TraceRecord record;
+  while (source.peekTime(peeked) && source.next(record)) {
+    peekMatches = peekMatches && peeked == record.time;
+    merged.push_back(std::make_pair(record.time, record.sourceId));
+  }
+  std::vector<std::pair<double, int>> expected = { { 0.5, 2 }, { 1.0, 1 }, { 3.0, 1 }, { 3.0, 1 }, { 3.0, 2 }, { 4.0, 2 } };
+  expect(merged == expected, "       ");
+  expect(peekMatches && !source.peekTime(peeked) && !source.next(record), "peekTime    ,  ");
+
+  std::remove(first.c_str());
+  std::remove(second.c_str());
+  std::remove(third.c_str());
+}
+
+void testLoadAfterStart() {
+  std::string path = writeCsv("trace_source_test.csv", "1.0,1,0\n");
+  SimulationConfig config;
+  config.seed = 1;
+  SimulationController controller(config);
+  controller.stepSimulation();
+  expectThrows<std::logic_error>("    ", [&]() { controller.loadTrace({ path }); });
+
+  SimulationController fresh(config);
+  fresh.loadTrace({ path });
+  fresh.runToCompletion();
+  int generated = 0;
+  for (const SourceResults& s : fresh.getResults().sources) {
+    generated += s.generated;
+  }
+  expect(generated == 1, "   :  " + std::to_string(generated));
+  std::remove(path.c_str());
+}
+
+}
+
+int main() {
+  testCsvParsing();
+  testBinaryParsing();
+  testMerge();
+  testLoadAfterStart();
+  return testSummary("TraceSource");
+}
@@ -0,0 +1,179 @@
+#include "TraceSource.h"
+#include <charconv>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <cmath>
+
+namespace {
+
+const char BINARY_MAGIC[8] = { 'S', 'C', 'T', 'R', 'A', 'C', 'E', '1' };
+const size_t BINARY_RECORD_SIZE = sizeof(double) + 2 * sizeof(int32_t) + sizeof(double);
+
+//      
+const char* skipBlanks(const char* p, const char* end) {
+  while (p < end && (*p == ' ' || *p == '\t')) {
+    ++p;
+  }
+  return p;
+}
+
+//  :     '\r' (   Windows)
+bool atLineEnd(const char* p, const char* lineEnd) {
+  p = skipBlanks(p, lineEnd);
+  if (p < lineEnd && *p == '\r') {
+    p = skipBlanks(p + 1, lineEnd);
+  }
+  return p == lineEnd;
+}
+
+}
+
+TraceReader::TraceReader(const std::string& path)
+  : file(path), cursor(file.begin()), binary(false), nextPrefetch(0), lineNumber(0), lastTime(0.0) {
+  if (file.size() >= sizeof(BINARY_MAGIC) && std::memcmp(file.begin(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0) {
+    binary = true;
+    cursor += sizeof(BINARY_MAGIC);
+  }
+}
+
+void TraceReader::fail(const std::string& message) const {
+  throw std::runtime_error(" " + file.getPath() + ",  " + std::to_string(lineNumber) + ": " + message);
+}
+
+bool TraceReader::next(TraceRecord& out) {
+  //    ,   
+  size_t offset = static_cast<size_t>(cursor - file.begin());
+  if (offset >= nextPrefetch) {
+    file.prefetch(offset + PREFETCH_WINDOW, PREFETCH_WINDOW);
+    nextPrefetch = offset + PREFETCH_WINDOW;
+  }
+
+  bool found = binary ? readBinaryRecord(out) : parseCsvLine(out);
+  if (!found) {
+    return false;
+  }
+  //     :   NaN  , CSV - "-nan"  "-inf"
+  if (!std::isfinite(out.time) || out.time < 0.0) {
+    fail("  .");
+  }
+  if (!std::isfinite(out.serviceTime)) {
+    fail("  .");
+  }
+  if (out.time < lastTime) {
+    fail("    .");
+  }
+  lastTime = out.time;
+  return true;
+}
+
+bool TraceReader::readBinaryRecord(TraceRecord& out) {
+  if (static_cast<size_t>(file.end() - cursor) < BINARY_RECORD_SIZE) {
+    return false;
+  }
+  ++lineNumber;
+  int32_t sourceId;
+  int32_t priority;
+  // memcpy   :     
+  std::memcpy(&out.time, cursor, sizeof(double));
+  std::memcpy(&sourceId, cursor + sizeof(double), sizeof(int32_t));
+  std::memcpy(&priority, cursor + sizeof(double) + sizeof(int32_t), sizeof(int32_t));
+  std::memcpy(&out.serviceTime, cursor + sizeof(double) + 2 * sizeof(int32_t), sizeof(double));
+  cursor += BINARY_RECORD_SIZE;
+
+  if (priority < 0 || priority > 2) {
+    fail(" .");
+  }
+  out.sourceId = sourceId;
+  out.priority = static_cast<Priority>(priority);
+  return true;
+}
+
+bool TraceReader::parseCsvLine(TraceRecord& out) {
+  const char* end = file.end();
+  while (cursor < end) {
+    const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+    if (!lineEnd) {
+      lineEnd = end;
+    }
+    const char* p = skipBlanks(cursor, lineEnd);
+    const char* next = (lineEnd < end) ? lineEnd + 1 : end;
+    ++lineNumber;
+
+    // ,    
+    if (p == lineEnd || !((*p >= '0' && *p <= '9') || *p == '.' || *p == '-')) {
+      cursor = next;
+      continue;
+    }
+
+    int priority = 0;
+    auto time = std::from_chars(p, lineEnd, out.time);
+    if (time.ec != std::errc() || (p = skipBlanks(time.ptr, lineEnd)) == lineEnd || *p != ',') {
+      fail("  .");
+    }
+    p = skipBlanks(p + 1, lineEnd);
+    auto source = std::from_chars(p, lineEnd, out.sourceId);
+    if (source.ec != std::errc() || (p = skipBlanks(source.ptr, lineEnd)) == lineEnd || *p != ',') {
+      fail("  .");
+    }
+    p = skipBlanks(p + 1, lineEnd);
+    auto pri = std::from_chars(p, lineEnd, priority);
+    if (pri.ec != std::errc() || priority < 0 || priority > 2) {
+      fail(" .");
+    }
+    out.priority = static_cast<Priority>(priority);
+
+    //    (  -  )
+    out.serviceTime = -1.0;
+    p = skipBlanks(pri.ptr, lineEnd);
+    if (p < lineEnd && *p == ',') {
+      p = skipBlanks(p + 1, lineEnd);
+      if (!atLineEnd(p, lineEnd)) {
+        auto service = std::from_chars(p, lineEnd, out.serviceTime);
+        if (service.ec != std::errc() || !atLineEnd(service.ptr, lineEnd)) {
+          fail("  .");
+        }
+      }
+    }
+    else if (!atLineEnd(p, lineEnd)) {
+      fail(" .");
+    }
+
+    cursor = next;
+    return true;
+  }
+  return false;
+}
+
+TraceSource::TraceSource(const std::vector<std::string>& paths) {
+  for (const std::string& path : paths) {
+    readers.emplace_back(new TraceReader(path));
+  }
+  heads.resize(readers.size());
+  for (size_t i = 0; i < readers.size(); ++i) {
+    if (readers[i]->next(heads[i])) {
+      order.push(std::make_pair(heads[i].time, static_cast<int>(i)));
+    }
+  }
+}
+
+bool TraceSource::next(TraceRecord& out) {
+  if (order.empty()) {
+    return false;
+  }
+  int index = order.top().second;
+  order.pop();
+  out = heads[index];
+  if (readers[index]->next(heads[index])) {
+    order.push(std::make_pair(heads[index].time, index));
+  }
+  return true;
+}
+
+bool TraceSource::peekTime(double& time) const {
+  if (order.empty()) {
+    return false;
+  }
+  time = order.top().first;
+  return true;
+}
@@ -0,0 +1,69 @@
+#ifndef TRACESOURCE_H
+#define TRACESOURCE_H
+
+#include "Request.h"
+#include "MappedFile.h"
+#include <string>
+#include <vector>
+#include <queue>
+#include <memory>
+#include <functional>
+
+//   
+struct TraceRecord {
+  double time;          //  
+  int sourceId;         //  () 
+  Priority priority;    //  
+  double serviceTime;   //    , < 0 -  
+
+  TraceRecord() : time(0.0), sourceId(0), priority(Priority::PRIVATE), serviceTime(-1.0) {}
+};
+
+//    ,   .
+//   :
+//  - CSV: ",,[, ]" ( - 0 , 1 , 2 ),
+//    ,     (, ), ;    
+//           ("1.0,2,1xyz" - );
+//  - :  "SCTRACE1",   {double ; int32 ; int32 ; double }.
+//     ,   ,   std::runtime_error.
+class TraceReader {
+private:
+  MappedFile file;
+  const char* cursor;
+  bool binary;
+  size_t nextPrefetch;   // ,      
+  long long lineNumber;
+  double lastTime;
+
+  static const size_t PREFETCH_WINDOW = 8u << 20; //    (8 )
+
+  bool parseCsvLine(TraceRecord& out);
+  bool readBinaryRecord(TraceRecord& out);
+  [[noreturn]] void fail(const std::string& message) const;
+
+public:
+  TraceReader(const std::string& path);
+
+  //     .  false   
+  bool next(TraceRecord& out);
+};
+
+//     ,    
+class TraceSource {
+private:
+  std::vector<std::unique_ptr<TraceReader>> readers;
+  std::vector<TraceRecord> heads; //    
+  // (,  ):         
+  std::priority_queue<std::pair<double, int>, std::vector<std::pair<double, int>>, std::greater<std::pair<double, int>>> order;
+
+public:
+  TraceSource(const std::vector<std::string>& paths);
+
+  //       .  false,   
+  bool next(TraceRecord& out);
+
+  //        .  false,   
+  bool peekTime(double& time) const;
+};
+
+#endif
@@ -6,14 +6,22 @@
 #include <iomanip>
 #include <csignal>
 #include <cstdlib>
+#include <thread>
+#include <sstream>
+#include <string>
 
 #include "SimulationController.h"
+#include "RealTimeController.h"
+#include "BufferBenchmark.h"
+#include "CapacityOptimizer.h"
+#include "ShardedSimulation.h"
+#include "RegressionHarness.h"
 
-//     
-volatile sig_atomic_t g_signalRaised = 0;
+//  ,   ,   ;   SIGINT
+CancellationToken g_interruptToken;
 
-void signalHandler(int signal) {
-  g_signalRaised = signal;
+void signalHandler(int) {
+  g_interruptToken.cancel();
 }
 
 using namespace std;
@@ -25,13 +33,174 @@ int main() {
   cout << "   :" << endl;
   cout << "1.   (1)" << endl;
   cout << "2.   (1)" << endl;
-  cout << " 1  2: ";
+  cout << "3.    ()" << endl;
+  cout << "4.   " << endl;
+  cout << "5.    ( )" << endl;
+  cout << "6.        SLA" << endl;
+  cout << "7.   (  )" << endl;
+  cout << "8.      " << endl;
+  cout << "9.      " << endl;
+  cout << "10.      " << endl;
+  cout << "11.   (   )" << endl;
+  cout << "   (1-11): ";
 
   int mode_choice;
   cin >> mode_choice;
   cin.ignore();
 
+  if (mode_choice == 3) {
+    RealTimeConfig rtConfig;
+    cout << "\n     " << rtConfig.durationSeconds << " ..." << endl;
+    RealTimeController rtController(rtConfig);
+    rtController.run();
+    rtController.printSummary();
+    return 0;
+  }
+
+  if (mode_choice == 4) {
+    int threadCount = std::max(2u, std::thread::hardware_concurrency());
+    for (int bufferSize : { 5, 64, 1024 }) {
+      runBufferBenchmark(threadCount, bufferSize, 2.0);
+    }
+    return 0;
+  }
+
+  if (mode_choice == 6) {
+    SimulationConfig baseConfig;
+    baseConfig.simulationEndTime = 10000.0;
+    CapacityOptimizer optimizer(baseConfig, SlaTargets(), OptimizerSettings());
+    cout << "\n ..." << endl;
+    int best = optimizer.optimize();
+    optimizer.printReport(best);
+    return 0;
+  }
+
+  if (mode_choice == 7) {
+    for (RoutingPolicy policy : { RoutingPolicy::RANDOM, RoutingPolicy::ROUND_ROBIN, RoutingPolicy::JOIN_SHORTEST_QUEUE, RoutingPolicy::POWER_OF_D }) {
+      ShardedConfig shardedConfig;
+      shardedConfig.shardCount = 8;
+      shardedConfig.shard.simulationEndTime = 10000.0;
+      shardedConfig.shard.seed = 12345;
+      shardedConfig.policy = policy;
+      ShardedSimulation sharded(shardedConfig);
+      sharded.runToCompletion();
+      sharded.printSummary();
+    }
+    return 0;
+  }
+
+  if (mode_choice == 8) {
+    SimulationConfig profileConfig;
+    try {
+      for (size_t i = 0; i < profileConfig.sources.size(); ++i) {
+        cout << "    " << i + 1 << " (  -  ): ";
+        string path;
+        getline(cin, path);
+        if (!path.empty()) {
+          profileConfig.sources[i].arrivalProfile = std::make_shared<ArrivalProfile>(ArrivalProfile::loadFromFile(path));
+        }
+      }
+    }
+    catch (const std::exception& e) {
+      cout << e.what() << endl;
+      return 1;
+    }
+    cout << "  : ";
+    cin >> profileConfig.simulationEndTime;
+    SimulationController profileController(profileConfig);
+    profileController.setCancellationToken(g_interruptToken);
+    cout << "\n  ..." << endl;
+    profileController.runSimulationAutomatic();
+    return 0;
+  }
+
+  if (mode_choice == 9) {
+    SimulationConfig poolConfig;
+    poolConfig.simulationEndTime = 10000.0;
+    poolConfig.scaling.enabled = true;
+    poolConfig.scaling.minDevices = 1;
+    poolConfig.scaling.maxDevices = 8;
+    SimulationController poolController(poolConfig);
+    poolController.setCancellationToken(g_interruptToken);
+    cout << "\n     ..." << endl;
+    poolController.runSimulationAutomatic();
+    return 0;
+  }
+
+  if (mode_choice == 10) {
+    //   :         
+    for (SelectionDiscipline discipline : { SelectionDiscipline::LIFO_PRIORITY, SelectionDiscipline::EDF, SelectionDiscipline::AGING }) {
+      SimulationConfig disciplineConfig;
+      disciplineConfig.simulationEndTime = 10000.0;
+      disciplineConfig.bufferSize = 10;
+      disciplineConfig.seed = 12345;
+      disciplineConfig.selection.discipline = discipline;
+      SimulationController disciplineController(disciplineConfig);
+      disciplineController.setCancellationToken(g_interruptToken);
+      disciplineController.runSimulationAutomatic();
+    }
+    return 0;
+  }
+
+  if (mode_choice == 11) {
+    cout << "1 -   , 2 -  : ";
+    int action;
+    cin >> action;
+    RegressionHarness harness("golden_results.txt", "regression_history.csv");
+    try {
+      if (action == 2) {
+        harness.recordGolden();
+        harness.printReport();
+        return 0;
+      }
+      bool passed = harness.check();
+      harness.printReport();
+      if (!passed) {
+        cout << "   ." << endl;
+        return 1;
+      }
+      if (harness.hasPerformanceRegression()) {
+        cout << "   ,    ." << endl;
+        return 2;
+      }
+      cout << "  ." << endl;
+      return 0;
+    }
+    catch (const std::exception& e) {
+      cout << e.what() << endl;
+      return 1;
+    }
+  }
+
   SimulationController simController;
+  simController.setCancellationToken(g_interruptToken);
+
+  if (mode_choice == 5) {
+    cout << "   (CSV   )  : ";
+    string line;
+    getline(cin, line);
+    istringstream pathStream(line);
+    vector<string> paths;
+    string path;
+    while (pathStream >> path) {
+      paths.push_back(path);
+    }
+    cout << "  : ";
+    double endTime;
+    cin >> endTime;
+    //        
+    try {
+      simController.loadTrace(paths);
+      simController.setSimulationEndTime(endTime);
+      cout << "\n  ..." << endl;
+      simController.runSimulationAutomatic();
+    }
+    catch (const std::exception& e) {
+      cout << e.what() << endl;
+      return 1;
+    }
+    return 0;
+  }
 
   if (mode_choice == 1) {
     cout << "\n  ..." << endl;
@@ -47,7 +216,7 @@ int main() {
   }
 
   // ,     
-  if (g_signalRaised == SIGINT && mode_choice == 1) {
+  if (g_interruptToken.isCancelled() && mode_choice == 1) {
     std::cout << "\n  SIGINT (Ctrl+C).  ." << std::endl;
     return 0;
   }